@@ -21,6 +21,7 @@
 #include "gt_globals.h"
 #include "gt_versionnumber.h"
 #include "gt_python.h"
+#include "gtpy_workerpool.h"
 
 using namespace std;
 
@@ -66,6 +67,93 @@ parseScriptFile(const QString& filename)
     return out.readAll();
 }
 
+/**
+ * @brief Sends the script file to a running script server (started with
+ * --py-server <name>) and prints its output. The application is not
+ * initialized by the client.
+ * @param serverName Name of the script server.
+ * @param args Arguments. The first one is the script file.
+ * @return 0 on success, -1 otherwise
+ */
+int
+runOnServer(const QString& serverName, const QStringList& args)
+{
+    if (args.isEmpty())
+    {
+        cout << "ERROR: no script file given!" << endl;
+        return -1;
+    }
+
+    GtpyWorkerRequest request;
+    request.script = parseScriptFile(args.first());
+    request.batch = true;
+
+    if (request.script.isEmpty())
+    {
+        cout << "ERROR: empty script file!" << endl;
+        return -1;
+    }
+
+    auto response = GtpyWorkerPool::request(serverName, request);
+
+    if (!response.error.isEmpty())
+    {
+        cout << "ERROR: " << response.error.toStdString() << endl;
+        return -1;
+    }
+
+    cout << response.output.join(QString()).toStdString();
+    cerr << response.errors.join(QString()).toStdString();
+
+    return response.success ? 0 : -1;
+}
+
+/**
+ * @brief Returns whether the thin client mode is requested by --connect.
+ * @param argc Argument count.
+ * @param argv Arguments.
+ * @return True if --connect is given.
+ */
+bool
+isClientMode(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (qstrcmp(argv[i], "--connect") == 0) return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Runs the thin client mode. Neither a GUI application nor the splash
+ * screen is created, so that the client starts quickly.
+ * @param argc Argument count.
+ * @param argv Arguments.
+ * @return 0 on success, -1 otherwise
+ */
+int
+runClient(int argc, char* argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    QStringList args = a.arguments();
+    args.removeAt(0);
+
+    int connectIdx = args.indexOf(QStringLiteral("--connect"));
+
+    if (connectIdx + 1 >= args.size())
+    {
+        cout << "ERROR: no script server given!" << endl;
+        return -1;
+    }
+
+    QString serverName = args.at(connectIdx + 1);
+    args.erase(args.begin() + connectIdx, args.begin() + connectIdx + 2);
+
+    return runOnServer(serverName, args);
+}
+
 int main(int argc, char* argv[])
 {
     QCoreApplication::setOrganizationDomain("www.dlr.de");
@@ -78,6 +166,12 @@ int main(int argc, char* argv[])
     QCoreApplication::setApplicationVersion(GtApplication::version().toString());
 #endif
 
+    // thin client mode: the script is evaluated by a warm script server
+    if (isClientMode(argc, argv))
+    {
+        return runClient(argc, argv);
+    }
+
     QApplication a(argc, argv);
 
     showSplashScreen();
@@ -88,15 +182,15 @@ int main(int argc, char* argv[])
     parser.addHelpOption();
     parser.addVersionOption();
 
+    QStringList args = qApp->arguments();
+    args.removeAt(0);
+
     GtApplication app(qApp);
     app.init();
 
     // save to system environment (temporary)
     app.saveSystemEnvironment();
 
-    QStringList args = qApp->arguments();
-    args.removeAt(0);
-
     return PythonExecution::runPythonInterpreter(args);
 
 }
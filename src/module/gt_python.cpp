@@ -8,6 +8,9 @@
  * Author: Stanislaus Reitenbach (DLR AT-TWK)
  */
 
+#include <algorithm>
+#include <iostream>
+
 #include <QApplication>
 #include <QTabWidget>
 #include <QPushButton>
@@ -56,6 +59,8 @@
 
 #include "gtpy_scriptcollectionsettings.h"
 #include "gtpy_moduleupgrader.h"
+#include "gtpy_workerpool.h"
+#include "gtpy_batchrunner.h"
 
 #include "gt_python.h"
 
@@ -161,7 +166,7 @@ GtPythonModule::init()
 
     if (!GtpyContextManager::instance()->initMatplotlib())
     {
-        gtError() << "Unable to register matplotlib backend. Is matplotlib installed?";
+        gtError() << "Unable to register matplotlib backend.";
     }
 }
 
@@ -365,27 +370,185 @@ parseScriptFile(QFile& file)
 }
 
 
+/**
+ * @brief Removes the given option and its value from the given arguments.
+ * @param args Command line arguments.
+ * @param option Name of the option.
+ * @return Value of the option. Empty if the option is not given.
+ */
+QString
+takeOptionValue(QStringList& args, const QString& option)
+{
+    int idx = args.indexOf(option);
+
+    if (idx < 0 || idx + 1 >= args.size())
+    {
+        return {};
+    }
+
+    QString value = args.at(idx + 1);
+
+    args.erase(args.begin() + idx, args.begin() + idx + 2);
+
+    return value;
+}
+
+/**
+ * @brief Removes the given count option and its value from the given
+ * arguments.
+ * @param args Command line arguments.
+ * @param option Name of the option.
+ * @return Given count. Zero if the option is not given.
+ */
 int
-runPythonInterpreter(const QStringList& args)
+takeCountOption(QStringList& args, const QString& option)
 {
-    if (args.isEmpty())
+    bool ok = false;
+    int count = takeOptionValue(args, option).toInt(&ok);
+
+    return ok ? count : 0;
+}
+
+/**
+ * @brief Runs the given script files in isolated batch contexts and prints
+ * or writes the JSON summary of the run.
+ * @param scriptArgs Script files or glob patterns.
+ * @param jobs Number of scripts evaluated concurrently.
+ * @param summaryFile File to write the summary to. If it is empty, the
+ * summary is printed to stdout.
+ * @return 0 if all scripts succeeded, -1 otherwise
+ */
+int
+runBatchScripts(const QStringList& scriptArgs, int jobs,
+                const QString& summaryFile)
+{
+    QStringList files = gtpy::batch::expandScripts(scriptArgs);
+
+    if (files.isEmpty())
     {
+        gtError() << "ERROR: no script files found!";
         return -1;
     }
 
-    QFile f(args.first());
-    QString scriptContent = parseScriptFile(f);
+    gtInfo() << "Start Python Script Execution for" << files.size()
+             << "files with" << jobs << "jobs";
+
+    GtpyContextManager::instance()->initContexts();
+
+    auto results = gtpy::batch::run(files, jobs);
+    QByteArray summary = gtpy::batch::summary(results);
+
+    if (summaryFile.isEmpty())
+    {
+        std::cout << summary.constData() << std::endl;
+    }
+    else
+    {
+        QFile file(summaryFile);
+
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            gtError() << "ERROR: could not write summary file"
+                      << summaryFile;
+            return -1;
+        }
+
+        file.write(summary);
+    }
+
+    bool success = std::all_of(results.begin(), results.end(),
+                               [](const gtpy::batch::ScriptResult& r){
+        return r.success;
+    });
+
+    return success ? 0 : -1;
+}
 
-    if (scriptContent.isEmpty())
+int
+runPythonInterpreter(const QStringList& args)
+{
+    if (args.isEmpty())
     {
-        gtError() << "ERROR: empty script file!";
         return -1;
     }
 
-    gtInfo() << "Start Python Script Execution for file" << args.first();
     GtpyContextManager* python = GtpyContextManager::instance();
     assert(python);
 
+    if (args.first() == GtpyWorkerPool::WORKER_ARG ||
+        args.first() == GtpyWorkerPool::SERVER_ARG)
+    {
+        if (args.size() < 2)
+        {
+            return -1;
+        }
+
+        python->initContexts();
+
+        bool resident = args.first() == GtpyWorkerPool::SERVER_ARG;
+
+        if (resident)
+        {
+            gtInfo() << "Python script server listening on" << args.at(1);
+        }
+
+        return GtpyWorkerPool::serve(args.at(1), resident);
+    }
+
+    QStringList scriptArgs = args;
+    int taskWorkers = takeCountOption(scriptArgs,
+                                      QStringLiteral("--task-workers"));
+    int jobs = takeCountOption(scriptArgs, QStringLiteral("--jobs"));
+    QString summaryFile = takeOptionValue(scriptArgs,
+                                          QStringLiteral("--summary"));
+
+    if (scriptArgs.isEmpty())
+    {
+        return -1;
+    }
+
+    bool batchRun = jobs > 0 || !summaryFile.isEmpty() ||
+                    gtpy::batch::isPattern(scriptArgs.first());
+
+    QString scriptContent;
+
+    if (!batchRun)
+    {
+        QFile f(scriptArgs.first());
+        scriptContent = parseScriptFile(f);
+
+        if (scriptContent.isEmpty())
+        {
+            gtError() << "ERROR: empty script file!";
+            return -1;
+        }
+    }
+
+    if (taskWorkers > 0)
+    {
+        // workers are started with the same leading arguments as this
+        // process (e.g. the command line function name)
+        QStringList appArgs = QCoreApplication::arguments();
+        QStringList leadingArgs = appArgs.mid(
+            1, appArgs.size() - args.size() - 1);
+
+        auto* pool = GtpyWorkerPool::instance();
+        pool->setWorkerCommand(QCoreApplication::applicationFilePath(),
+                               leadingArgs);
+        pool->setWorkerCount(taskWorkers);
+    }
+
+    if (batchRun)
+    {
+        int retval = runBatchScripts(scriptArgs, qMax(jobs, 1), summaryFile);
+
+        GtpyWorkerPool::instance()->shutdown();
+
+        return retval;
+    }
+
+    gtInfo() << "Start Python Script Execution for file" << scriptArgs.first();
+
     python->initContexts();
 
     // print errors to console
@@ -398,6 +561,9 @@ runPythonInterpreter(const QStringList& args)
 
     bool success = python->evalScript(GtpyContextManager::BatchContext,
                                       scriptContent, true);
+
+    GtpyWorkerPool::instance()->shutdown();
+
     return success ? 0 : -1;
 }
 
@@ -199,7 +199,18 @@ namespace PythonExecution
 {
 
 /**
- * @brief Runs a standalone python interpreter given the file passed in args
+ * @brief Runs a standalone python interpreter given the file passed in args.
+ * If the option --task-workers <n> is given, the scripts of Python tasks are
+ * evaluated in up to n worker processes (see GtpyWorkerPool). If the first
+ * argument is --py-worker <name>, the process runs as such a worker. If it
+ * is --py-server <name>, the process runs as resident script server, which
+ * evaluates batch scripts sent by clients in new batch contexts.
+ *
+ * If the option --jobs <n> or --summary <file> is given or the first file
+ * is a glob pattern, all given files are evaluated in isolated batch
+ * contexts, up to n at a time, and a JSON summary with the result, wall
+ * time and output of each script is printed or written to the given file.
+ * Scripts of more than one job must not use the application or project API.
  * @param args The first parameter is the file to execute
  * @return 0 on success, -1 otherwise
  */
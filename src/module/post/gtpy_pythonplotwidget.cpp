@@ -17,10 +17,17 @@
 #include <QSvgWidget>
 #include <QSvgRenderer>
 #include <QFile>
+#include <QCache>
+#include <QPointer>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QCryptographicHash>
 
 #include "gt_stylesheets.h"
 #include "gtpy_contextmanager.h"
+#include "gtpy_matplotlib.h"
 #include "gt_application.h"
+#include "gt_project.h"
 #include "gt_logging.h"
 
 #include "gtpy_pythonplotitem.h"
@@ -30,6 +37,268 @@
 
 #include "gtpy_pythonplotwidget.h"
 
+namespace
+{
+
+class PlotRunnable : public QRunnable
+{
+public:
+    explicit PlotRunnable(std::function<void()> func) :
+        m_func(std::move(func))
+    {}
+
+    void run() override { m_func(); }
+
+private:
+    std::function<void()> m_func;
+};
+
+/// Placeholder of the figure path in plot scripts
+const QString FIG_PATH = QStringLiteral("$fig_path$");
+
+/// Maximum total size of the cached figures in bytes
+constexpr int FIGURE_CACHE_SIZE = 64 * 1024 * 1024;
+
+/**
+ * Rendered figures by script and input data hash. It is only accessed from
+ * the GUI thread.
+ */
+QCache<QByteArray, QByteArray>&
+figureCache()
+{
+    static QCache<QByteArray, QByteArray> cache{FIGURE_CACHE_SIZE};
+    return cache;
+}
+
+/**
+ * Thread rendering the captured figures. They are rendered one at a time,
+ * because matplotlib does not render figures concurrently. The pool is
+ * owned by the application, which waits for a running rendering on exit.
+ */
+QThreadPool&
+plotThread()
+{
+    static auto* pool = [](){
+        auto* p = new QThreadPool{qApp};
+        p->setMaxThreadCount(1);
+        return p;
+    }();
+
+    return *pool;
+}
+
+/**
+ * Counts the changes of the current project. It replaces a hash of the
+ * whole project in the cache key of the figures, which would have to be
+ * calculated on the GUI thread for every plot. Changes are detected by the
+ * change signals of all objects of the project. It is owned by the
+ * application and only accessed from the GUI thread.
+ */
+class ProjectRevision : public QObject
+{
+public:
+    using QObject::QObject;
+
+    quint64 revision(GtProject* project)
+    {
+        if (project != m_project)
+        {
+            for (auto* obj : qAsConst(m_objects))
+            {
+                if (obj) disconnect(obj, nullptr, this, nullptr);
+            }
+
+            m_objects.clear();
+            m_project = project;
+            ++m_revision;
+
+            if (project) watch(project);
+        }
+
+        return m_revision;
+    }
+
+private:
+    QPointer<GtProject> m_project;
+
+    /// Objects whose change signals are connected
+    QList<QPointer<GtObject>> m_objects;
+
+    quint64 m_revision{0};
+
+    void bump() { ++m_revision; }
+
+    void onChildAppended(GtObject* child, GtObject* /*parent*/)
+    {
+        bump();
+        if (child) watch(child);
+    }
+
+    /**
+     * @brief Connects the change signals of the given object and of all of
+     * its descendants.
+     * @param obj Object to watch.
+     */
+    void watch(GtObject* obj)
+    {
+        QList<GtObject*> objects{obj};
+        objects.append(obj->findChildren<GtObject*>());
+
+        for (auto* o : qAsConst(objects))
+        {
+            connect(o, static_cast<void(GtObject::*)(GtObject*)>(
+                        &GtObject::dataChanged), this, &ProjectRevision::bump,
+                    Qt::UniqueConnection);
+            connect(o, static_cast<
+                        void(GtObject::*)(GtObject*, GtAbstractProperty*)>(
+                        &GtObject::dataChanged), this, &ProjectRevision::bump,
+                    Qt::UniqueConnection);
+            connect(o, &GtObject::childAppended, this,
+                    &ProjectRevision::onChildAppended, Qt::UniqueConnection);
+            // removed objects are deleted
+            connect(o, &QObject::destroyed, this, &ProjectRevision::bump,
+                    Qt::UniqueConnection);
+
+            m_objects.append(o);
+        }
+    }
+};
+
+/**
+ * @brief Returns the cache key of the figure of the given script. Plot
+ * scripts read their input data from the current project, so its revision
+ * is part of the key.
+ * @param script Plot script.
+ * @return Cache key.
+ */
+QByteArray
+figureKey(const QString& script)
+{
+    static auto* revision = new ProjectRevision{qApp};
+
+    QCryptographicHash hash{QCryptographicHash::Sha1};
+    hash.addData(script.toUtf8());
+
+    const quint64 projectRevision = revision->revision(
+        gtApp->currentProject());
+    hash.addData(reinterpret_cast<const char*>(&projectRevision),
+                 sizeof(projectRevision));
+
+    return hash.result();
+}
+
+/**
+ * @brief Evaluates the plot script in a new context and returns the token
+ * of the captured figures. Figures saved to the path placeholder or shown by
+ * the backend are captured without rendering them. Only placeholders that
+ * are not a plain string literal are replaced by the given file path. The
+ * script reads the project, so it must be called from the GUI thread.
+ * @param script Plot script.
+ * @param figPath Fallback file path of the figure.
+ * @return Token of the captured figures, 0 if they are not captured.
+ */
+long
+captureFigures(QString script, const QString& figPath)
+{
+    auto* python = GtpyContextManager::instance();
+
+    const int contextId = python->createNewContext(
+        GtpyContextManager::GlobalContext);
+
+    const QString prelude = QStringLiteral(
+        "import %1 as __gtpy_hook__\n"
+        "%2 = __gtpy_hook__.begin_capture()\n")
+            .arg(gtpy::matplotlib::hookName, gtpy::matplotlib::figureVariable);
+
+    const bool capturing = python->evalScript(contextId, prelude, false,
+                                              false);
+
+    if (capturing)
+    {
+        for (const auto& quote : {QStringLiteral("\""), QStringLiteral("'")})
+        {
+            script.replace(quote + FIG_PATH + quote,
+                           QString{gtpy::matplotlib::figureVariable});
+        }
+    }
+
+    script.replace(FIG_PATH, figPath);
+
+    python->evalScript(contextId, script, true);
+
+    long token = 0;
+
+    if (capturing)
+    {
+        GTPY_GIL_SCOPE
+
+        auto hook = PyPPImport_ImportModule(gtpy::matplotlib::hookName);
+        auto result = hook ? PyPPObject_CallMethod(hook, "end_capture", nullptr)
+                           : PyPPObject{};
+
+        if (result && PyLong_Check(result.get()))
+        {
+            token = PyPPLong_AsLong(result);
+        }
+
+        PyErr_Clear();
+    }
+
+    python->deleteContext(contextId);
+
+    return token;
+}
+
+/**
+ * @brief Renders the captured figures and returns the first one. The
+ * figures no longer refer to the project, so it may be called from any
+ * thread.
+ * @param token Token of the captured figures.
+ * @param figPath Fallback file path of the figure.
+ * @return Figure as SVG or PNG data.
+ */
+QByteArray
+renderFigure(long token, const QString& figPath)
+{
+    QList<QByteArray> figures;
+
+    if (token != 0)
+    {
+        GTPY_GIL_SCOPE
+
+        auto hook = PyPPImport_ImportModule(gtpy::matplotlib::hookName);
+        auto rendered = hook ? PyPPObject_CallMethod(hook, "render", "l", token)
+                             : PyPPObject{};
+
+        if (rendered && PyList_Check(rendered.get()))
+        {
+            for (Py_ssize_t i = 0; i < PyPPList_Size(rendered); ++i)
+            {
+                auto figure = PyPPList_GetItem(rendered, i);
+                if (!figure || !PyBytes_Check(figure.get())) continue;
+
+                figures.append(QByteArray{PyBytes_AS_STRING(figure.get()),
+                                          static_cast<int>(
+                                              PyBytes_GET_SIZE(figure.get()))});
+            }
+        }
+
+        PyErr_Clear();
+    }
+
+    QFile file{figPath};
+
+    if (file.exists())
+    {
+        if (file.open(QIODevice::ReadOnly)) figures.append(file.readAll());
+        file.remove();
+    }
+
+    return figures.isEmpty() ? QByteArray{} : figures.first();
+}
+
+} // namespace
+
 GtpyPythonPlotWidget::GtpyPythonPlotWidget(GtpyPythonPlotItem* dm,
         QWidget* parent) :
     GtAbstractPostWidget(parent), m_dm(dm)
@@ -136,36 +405,54 @@ GtpyPythonPlotWidget::createSvgPlot()
         return;
     }
 
-    GtpyContextManager* python = GtpyContextManager::instance();
+    const quint64 request = ++m_request;
 
     QString script = pData->script();
+    QByteArray key = figureKey(script);
+
+    if (auto* figure = figureCache().object(key))
+    {
+        showFigure(*figure);
+        return;
+    }
 
     QDir tempDir = gtApp->applicationTempDir();
 
     QString figUuid = QUuid::createUuid().toString();
     QString figPath = tempDir.absoluteFilePath("fig_" + figUuid + ".svg");
 
-    script = script.replace("$fig_path$", figPath);
+    // the script reads the project, only the rendering is moved off the GUI
+    // thread
+    const long token = captureFigures(script, figPath);
 
-    bool success = python->evalScript(GtpyContextManager::GlobalContext,
-                                      script, true);
+    QPointer<GtpyPythonPlotWidget> self{this};
 
-    gtDebug() << "python evaluation successful: " << success;
+    plotThread().start(new PlotRunnable([=](){
+        QByteArray figure = renderFigure(token, figPath);
 
-    if (QFile(figPath).exists())
-    {
-        m_labelStart->hide();
-        m_svgWid->show();
+        // the application object outlives the widget
+        QMetaObject::invokeMethod(qApp, [=](){
+            if (!figure.isEmpty())
+            {
+                figureCache().insert(key, new QByteArray{figure},
+                                     figure.size());
+            }
 
-        m_svgWid->load(figPath);
+            // results of replaced requests are only cached
+            if (self && self->m_request == request) self->showFigure(figure);
+        }, Qt::QueuedConnection);
+    }));
+}
 
-        //        QSvgRenderer* renderer = m_svgWid->renderer();
+void
+GtpyPythonPlotWidget::showFigure(const QByteArray& figure)
+{
+    if (figure.isEmpty()) return;
 
-        //        gtDebug() << "default size = " << renderer->defaultSize();
-        //        gtDebug() << "view box = " << renderer->viewBox();
+    m_labelStart->hide();
+    m_svgWid->show();
 
-        //        renderer->setViewBox(QRect(200,150, 200, 100));
-    }
+    m_svgWid->setFigure(figure);
 }
 
 void
@@ -99,11 +99,24 @@ private:
     /// svg widget
     GtpyPythonSvgWidget* m_svgWid;
 
+    /// Number of the latest plot request. Results of older requests are
+    /// not shown.
+    quint64 m_request{0};
+
     /**
-     * @brief Creates svg plot.
+     * @brief Creates svg plot. The script is evaluated in a worker thread,
+     * and the figure is shown when it is ready. Figures are cached by the
+     * script and the input data, so they are not rendered again when the
+     * plot is reopened.
      */
     void createSvgPlot();
 
+    /**
+     * @brief Shows the given figure.
+     * @param figure Figure as SVG or PNG data.
+     */
+    void showFigure(const QByteArray& figure);
+
 private slots:
     /**
      * @brief Overloaded function to open a configuration menu.
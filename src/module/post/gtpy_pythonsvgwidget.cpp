@@ -9,6 +9,7 @@
  */
 
 #include <QMouseEvent>
+#include <QPainter>
 #include <QRubberBand>
 
 #include <QSvgRenderer>
@@ -17,12 +18,118 @@
 
 #include "gtpy_pythonsvgwidget.h"
 
+namespace
+{
+
+/// Maximum total size of the rendered views of a widget in kilobytes
+constexpr int RENDERED_VIEWS_COST = 64 * 1024;
+
+} // namespace
+
 GtpyPythonSvgWidget::GtpyPythonSvgWidget(QWidget* parent) : QSvgWidget(parent),
-    m_rubberBand(nullptr)
+    m_rubberBand(nullptr),
+    m_renderedViews(RENDERED_VIEWS_COST)
 {
 
 }
 
+void
+GtpyPythonSvgWidget::setFigure(const QByteArray& data)
+{
+    const QByteArray head = data.left(256).trimmed();
+    const bool isSvg = head.startsWith("<?xml") || head.startsWith("<svg");
+
+    m_pixmap = QPixmap{};
+    m_pixmapViewBox = QRectF{};
+    m_renderedViews.clear();
+
+    // repainting large documents parses and tessellates all elements again
+    m_largeFigure = isSvg && data.size() >= LARGE_FIGURE_SIZE;
+
+    if (isSvg)
+    {
+        load(data);
+        return;
+    }
+
+    if (!m_pixmap.loadFromData(data))
+    {
+        gtWarning() << tr("Unsupported figure format");
+    }
+
+    m_pixmapViewBox = m_pixmap.rect();
+
+    updateGeometry();
+    update();
+}
+
+void
+GtpyPythonSvgWidget::paintEvent(QPaintEvent* event)
+{
+    if (!m_pixmap.isNull())
+    {
+        QPainter painter{this};
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        painter.drawPixmap(QRectF{rect()}, m_pixmap, m_pixmapViewBox);
+        return;
+    }
+
+    if (m_largeFigure)
+    {
+        if (const auto* view = renderedView())
+        {
+            QPainter painter{this};
+            painter.drawPixmap(0, 0, *view);
+            return;
+        }
+    }
+
+    QSvgWidget::paintEvent(event);
+}
+
+const QPixmap*
+GtpyPythonSvgWidget::renderedView()
+{
+    QSvgRenderer* rend = renderer();
+    if (!rend || !rend->isValid() || size().isEmpty()) return nullptr;
+
+    const qreal ratio = devicePixelRatioF();
+    const QRectF viewBox = rend->viewBoxF();
+
+    const QString key = QStringLiteral("%1,%2,%3,%4/%5x%6@%7")
+            .arg(viewBox.x()).arg(viewBox.y())
+            .arg(viewBox.width()).arg(viewBox.height())
+            .arg(width()).arg(height()).arg(ratio);
+
+    if (auto* view = m_renderedViews.object(key)) return view;
+
+    auto* view = new QPixmap{size() * ratio};
+    view->setDevicePixelRatio(ratio);
+    view->fill(Qt::transparent);
+
+    {
+        QPainter painter{view};
+        rend->render(&painter, QRectF{QPointF{}, QSizeF{size()}});
+    }
+
+    const int cost = qMax(1, view->width() * view->height() * 4 / 1024);
+
+    // a view that exceeds the cache is rendered again on the next repaint
+    if (!m_renderedViews.insert(key, view, cost)) return nullptr;
+
+    return view;
+}
+
+QSize
+GtpyPythonSvgWidget::figureSize() const
+{
+    if (!m_pixmap.isNull()) return m_pixmap.size();
+
+    QSvgRenderer* rend = renderer();
+
+    return rend ? rend->defaultSize() : QSize{};
+}
+
 void
 GtpyPythonSvgWidget::mousePressEvent(QMouseEvent* event)
 {
@@ -61,14 +168,21 @@ GtpyPythonSvgWidget::mouseReleaseEvent(QMouseEvent* event)
         gtDebug() << "rubberband position = " << m_rubberBand->pos();
 
         QSvgRenderer* rend = renderer();
+        const QSize defaultSize = figureSize();
+
+        if (defaultSize.isEmpty())
+        {
+            QSvgWidget::mouseReleaseEvent(event);
+            return;
+        }
 
         gtDebug() << "view box = " << rend->viewBox();
         gtDebug() << "size = " << size();
 
         double x_scale = double(size().width()) /
-                         double(rend->defaultSize().width());
+                         double(defaultSize.width());
         double y_scale = double(size().height()) /
-                         double(rend->defaultSize().height());
+                         double(defaultSize.height());
 
         gtDebug() << "x_scale = " << x_scale;
         gtDebug() << "y_scale = " << y_scale;
@@ -82,7 +196,15 @@ GtpyPythonSvgWidget::mouseReleaseEvent(QMouseEvent* event)
 
         gtDebug() << "new view box = " << newViewBox;
 
-        rend->setViewBox(newViewBox);
+        if (!m_pixmap.isNull())
+        {
+            m_pixmapViewBox = newViewBox;
+        }
+        else
+        {
+            rend->setViewBox(newViewBox);
+        }
+
         repaint();
     }
 
@@ -98,12 +220,12 @@ GtpyPythonSvgWidget::hasHeightForWidth() const
 int
 GtpyPythonSvgWidget::heightForWidth(int w) const
 {
-    QSvgRenderer* rend = renderer();
+    const QSize defaultSize = figureSize();
 
-    if (rend != nullptr)
+    if (!defaultSize.isEmpty())
     {
-        double ar = double(rend->defaultSize().height()) /
-                    double(rend->defaultSize().width());
+        double ar = double(defaultSize.height()) /
+                    double(defaultSize.width());
 
         return int(w * ar);
     }
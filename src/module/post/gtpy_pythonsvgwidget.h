@@ -12,6 +12,8 @@
 #define GTPY_PYTHONSVGWIDGET_H
 
 #include <QSvgWidget>
+#include <QCache>
+#include <QPixmap>
 
 class QRubberBand;
 
@@ -29,6 +31,18 @@ public:
      */
     explicit GtpyPythonSvgWidget(QWidget* parent = nullptr);
 
+    /// SVG figures of at least this size in bytes are rendered into cached
+    /// pixmaps instead of on every repaint
+    static constexpr int LARGE_FIGURE_SIZE = 1024 * 1024;
+
+    /**
+     * @brief Shows the given figure. SVG data is rendered as vector
+     * graphic, any other image format as raster image. Large SVG figures are
+     * rendered once per view box and widget size.
+     * @param data Figure data.
+     */
+    void setFigure(const QByteArray& data);
+
 
     /**
      * @brief mousePressEvent
@@ -62,10 +76,43 @@ public:
      */
     virtual int heightForWidth(int w) const Q_DECL_OVERRIDE;
 
+protected:
+    /**
+     * @brief Paints the raster image, if the figure is not an SVG.
+     * @param event Paint event.
+     */
+    void paintEvent(QPaintEvent* event) override;
+
 private:
     /// Rubber band
     QRubberBand* m_rubberBand;
 
+    /// Raster image of a figure that is not an SVG
+    QPixmap m_pixmap;
+
+    /// Shown part of the raster image
+    QRectF m_pixmapViewBox;
+
+    /// Large SVG figures are painted from the rendered views
+    bool m_largeFigure{false};
+
+    /// Rendered views of a large SVG figure by view box, size and device
+    /// pixel ratio. The cost is given in kilobytes.
+    QCache<QString, QPixmap> m_renderedViews;
+
+    /**
+     * @brief Returns the rendered current view of a large SVG figure. The
+     * view is rendered if it is not cached yet.
+     * @return Rendered view.
+     */
+    const QPixmap* renderedView();
+
+    /**
+     * @brief Returns the size of the shown figure.
+     * @return Default size of the SVG or size of the raster image.
+     */
+    QSize figureSize() const;
+
     /// Rubber band origin
     QPoint m_origin;
 
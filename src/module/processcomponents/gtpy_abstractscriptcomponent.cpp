@@ -13,6 +13,8 @@
 #include "gt_package.h"
 #include "gt_objectpath.h"
 #include "gt_objectpathproperty.h"
+#include "gt_objectmemento.h"
+#include "gt_objectmementodiff.h"
 
 #if GT_VERSION >= GT_VERSION_CHECK(2, 0, 0)
 #include "gt_structproperty.h"
@@ -28,6 +30,8 @@
 #endif
 
 #include "gtpy_transfer.h"
+#include "gtpy_codecache.h"
+#include "gtpy_workerpool.h"
 #include "gtpy_contextmanager.h"
 #include "gtpy_packageiteration.h"
 
@@ -169,6 +173,10 @@ GtpyAbstractScriptComponent::script() const
 void
 GtpyAbstractScriptComponent::setScript(const QString& script)
 {
+    // the compiled code of the previous script is no longer needed
+    const auto oldScript = this->script();
+    if (oldScript != script) gtpy::codecache::invalidate(oldScript);
+
 #if GT_VERSION <= GT_VERSION_CHECK(1, 7, 0)
     m_script = QString{script}.replace("\n", "\r");
 #else
@@ -274,3 +282,88 @@ GtpyAbstractScriptComponent::evalScript(int contextId)
 
     return success;
 }
+
+bool
+GtpyAbstractScriptComponent::evalScriptInWorker(const QString& loggingPrefix)
+{
+    GtpyWorkerRequest request;
+    request.script = script();
+    request.loggingPrefix = loggingPrefix;
+
+    QList<GtPackage*> packages;
+    QList<GtObjectMemento> mementos;
+
+    for (auto* pathProp : qAsConst(m_dynamicPathProps))
+    {
+        auto* pkg = dataPackage(pathProp->path());
+        auto memento = pkg ? pkg->toMemento() : GtObjectMemento{};
+
+        packages.append(pkg);
+        request.packages.append(pkg ? memento.toByteArray() : QByteArray{});
+        mementos.append(std::move(memento));
+    }
+
+#if GT_VERSION >= GT_VERSION_CHECK(2, 0, 0)
+    request.inputArgs = gtpy::transfer::propStructToMap(m_inputArgs);
+    request.outputArgs = gtpy::transfer::propStructToMap(m_outputArgs);
+#endif
+
+    gtInfo() << "running script in worker process...";
+
+    m_workerTerminationRequested = false;
+
+    // the worker is killed if the termination is requested
+    auto response = GtpyWorkerPool::instance()->run(request, [this](){
+        return m_workerTerminationRequested.load();
+    });
+
+    if (!response.error.isEmpty())
+    {
+        gtError() << response.error;
+        return false;
+    }
+
+    // forward the output of the worker to the consoles
+    auto* ctxMgr = GtpyContextManager::instance();
+
+    for (const auto& msg : qAsConst(response.output))
+    {
+        emit ctxMgr->pythonMessage(msg, GtpyContextManager::TaskRunContext,
+                                   loggingPrefix);
+    }
+
+    for (const auto& msg : qAsConst(response.errors))
+    {
+        emit ctxMgr->errorMessage(msg, GtpyContextManager::TaskRunContext,
+                                  loggingPrefix);
+    }
+
+#if GT_VERSION >= GT_VERSION_CHECK(2, 0, 0)
+    gtpy::transfer::propStructFromMap(response.outputArgs, m_outputArgs);
+#endif
+
+    // apply the changes made by the script as a diff, so that unchanged
+    // objects of the packages are kept as they are
+    const int n = std::min(packages.size(), response.packages.size());
+
+    for (int i = 0; i < n; ++i)
+    {
+        auto* pkg = packages.at(i);
+        if (!pkg || response.packages.at(i).isEmpty()) continue;
+
+        GtObjectMementoDiff diff(mementos.at(i),
+                                 GtObjectMemento{response.packages.at(i)});
+
+        if (diff.numberOfDiffSteps() > 0 && !pkg->applyDiff(diff))
+        {
+            gtError() << QObject::tr("Could not apply the changes of the "
+                                     "worker process to")
+                      << pkg->objectName();
+            response.success = false;
+        }
+    }
+
+    gtInfo() << "...done!";
+
+    return response.success;
+}
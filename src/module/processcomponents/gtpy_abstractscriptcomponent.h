@@ -11,6 +11,8 @@
 #ifndef GTPYCOMPONENTASSISTANT_H
 #define GTPYCOMPONENTASSISTANT_H
 
+#include <atomic>
+
 #include "gt_globals.h"
 #include "gt_stringproperty.h"
 #include "gt_intproperty.h"
@@ -117,6 +119,10 @@ protected:
     /// Python thread id
     long m_pyThreadId;
 
+    /// Set when the termination of a script running in a worker process is
+    /// requested. It is polled by evalScriptInWorker().
+    mutable std::atomic<bool> m_workerTerminationRequested{false};
+
     /// Replace Tab By Spaces.
     GtBoolProperty m_replaceTabBySpaces;
 
@@ -146,6 +152,17 @@ protected:
      */
     bool evalScript(int contextId);
 
+    /**
+     * @brief Evaluates the script in a process of the GtpyWorkerPool. The
+     * available packages and the input and output property struct containers
+     * are transferred to the worker in a single request. The changes made by
+     * the script are applied to the packages and the output property struct
+     * container afterwards.
+     * @param loggingPrefix Prefix of the log messages emitted by the script.
+     * @return True, if the evaluation was successful.
+     */
+    bool evalScriptInWorker(const QString& loggingPrefix);
+
 private:
     /**
      * @brief Must be implemented by classes derived from this class.
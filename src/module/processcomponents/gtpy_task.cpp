@@ -12,6 +12,7 @@
 #include "gt_objectpathproperty.h"
 #include "gt_processdata.h"
 
+#include "gtpy_workerpool.h"
 #include "gtpy_contextmanager.h"
 #include "gtpy_wizardgeometries.h"
 
@@ -54,6 +55,15 @@ GtpyTask::~GtpyTask()
 bool
 GtpyTask::runIteration()
 {
+    if (GtpyWorkerPool::instance()->isEnabled())
+    {
+        auto success = evalScriptInWorker(objectName());
+
+        emit transferMonitoringProperties();
+
+        return success;
+    }
+
     int contextId = GtpyContextManager::instance()->createNewContext(
         GtpyContextManager::TaskRunContext, true);
 
@@ -87,7 +97,12 @@ GtpyTask::dataPackage(const GtObjectPath& pkgPath)
 void
 GtpyTask::onStateChanged(STATE state) const
 {
-    if (m_pyThreadId >= 0 && state == GtProcessComponent::TERMINATION_REQUESTED)
+    if (state != GtProcessComponent::TERMINATION_REQUESTED) return;
+
+    // scripts running in a worker process are stopped by killing the worker
+    m_workerTerminationRequested = true;
+
+    if (m_pyThreadId >= 0)
     {
         GtpyContextManager::instance()->interruptPyThread(m_pyThreadId);
     }
@@ -0,0 +1,216 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: gtpy_batchrunner.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QRunnable>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QElapsedTimer>
+
+#include "gtpy_contextmanager.h"
+
+#include "gtpy_batchrunner.h"
+
+namespace
+{
+
+/// Whether the thread evaluates a script of a parallel batch run
+thread_local bool parallelJob = false;
+
+/**
+ * Evaluates one script in a new batch context and collects its output.
+ */
+class ScriptRunnable : public QRunnable
+{
+public:
+    ScriptRunnable(gtpy::batch::ScriptResult& result, bool parallel) :
+        m_result(result), m_parallel(parallel)
+    {}
+
+    void run() override
+    {
+        // pool threads are reused, so the flag is set for each script
+        parallelJob = m_parallel;
+        evaluate();
+        parallelJob = false;
+    }
+
+private:
+    gtpy::batch::ScriptResult& m_result;
+
+    /// Whether the script runs in a parallel job
+    bool m_parallel;
+
+    void evaluate()
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        QFile file(m_result.file);
+
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        {
+            m_result.errors = QStringLiteral("could not open script file");
+            return;
+        }
+
+        QString script = QTextStream(&file).readAll();
+        file.close();
+
+        auto* python = GtpyContextManager::instance();
+
+        int contextId = python->createNewContext(
+            GtpyContextManager::BatchContext);
+
+        // output is emitted in the thread evaluating the script and has to
+        // be collected there, the calling thread is blocked meanwhile
+        auto outConn = QObject::connect(
+            python, &GtpyContextManager::pythonMessage, python,
+            [this, contextId](const QString& message, int id,
+                              const QString&){
+            if (id == contextId) m_result.output += message;
+        }, Qt::DirectConnection);
+
+        auto errConn = QObject::connect(
+            python, &GtpyContextManager::errorMessage, python,
+            [this, contextId](const QString& message, int id,
+                              const QString&){
+            if (id == contextId) m_result.errors += message;
+        }, Qt::DirectConnection);
+
+        m_result.success = python->evalScript(contextId, script, true);
+
+        QObject::disconnect(outConn);
+        QObject::disconnect(errConn);
+
+        python->deleteContext(contextId);
+
+        m_result.wallTime = timer.elapsed();
+    }
+};
+
+} // namespace
+
+bool
+gtpy::batch::isPattern(const QString& arg)
+{
+    return arg.contains(QLatin1Char('*')) || arg.contains(QLatin1Char('?')) ||
+           arg.contains(QLatin1Char('['));
+}
+
+bool
+gtpy::batch::isParallelJob()
+{
+    return parallelJob;
+}
+
+QStringList
+gtpy::batch::expandScripts(const QStringList& args)
+{
+    QStringList files;
+
+    for (const QString& arg : args)
+    {
+        if (!isPattern(arg))
+        {
+            files << arg;
+            continue;
+        }
+
+        QFileInfo info(arg);
+        QDir dir = info.dir();
+
+        const auto matches = dir.entryInfoList({info.fileName()},
+                                               QDir::Files, QDir::Name);
+
+        for (const QFileInfo& match : matches)
+        {
+            files << match.filePath();
+        }
+    }
+
+    return files;
+}
+
+QList<gtpy::batch::ScriptResult>
+gtpy::batch::run(const QStringList& files, int jobs)
+{
+    QList<ScriptResult> results;
+
+    for (const QString& file : files)
+    {
+        ScriptResult result;
+        result.file = file;
+        results << result;
+    }
+
+    if (jobs <= 1)
+    {
+        // sequential runs stay in the calling thread like a single script
+        for (auto& result : results)
+        {
+            ScriptRunnable runnable(result, false);
+            runnable.run();
+        }
+
+        return results;
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(jobs);
+
+    // the results are not resized while the runnables refer to them
+    for (auto& result : results)
+    {
+        pool.start(new ScriptRunnable(result, true));
+    }
+
+    pool.waitForDone();
+
+    return results;
+}
+
+QByteArray
+gtpy::batch::summary(const QList<ScriptResult>& results)
+{
+    QJsonArray scripts;
+
+    int succeeded = 0;
+    qint64 wallTime = 0;
+
+    for (const ScriptResult& result : results)
+    {
+        QJsonObject script;
+        script.insert(QStringLiteral("file"), result.file);
+        script.insert(QStringLiteral("success"), result.success);
+        script.insert(QStringLiteral("wallTimeMs"),
+                      static_cast<double>(result.wallTime));
+        script.insert(QStringLiteral("output"), result.output);
+        script.insert(QStringLiteral("errors"), result.errors);
+
+        scripts.append(script);
+
+        if (result.success) ++succeeded;
+        wallTime += result.wallTime;
+    }
+
+    QJsonObject root;
+    root.insert(QStringLiteral("scripts"), scripts);
+    root.insert(QStringLiteral("succeeded"), succeeded);
+    root.insert(QStringLiteral("failed"), results.size() - succeeded);
+    root.insert(QStringLiteral("totalScriptTimeMs"),
+                static_cast<double>(wallTime));
+
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
@@ -0,0 +1,108 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: gtpy_batchrunner.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#ifndef GTPY_BATCHRUNNER_H
+#define GTPY_BATCHRUNNER_H
+
+#include <QList>
+#include <QString>
+#include <QByteArray>
+#include <QStringList>
+
+#include "gt_pythonmodule_exports.h"
+
+namespace gtpy
+{
+
+/**
+ * Runs several independent batch scripts in one initialized application.
+ * Each script is evaluated in its own batch context, so the scripts do not
+ * share any Python state. Up to a given number of scripts are evaluated
+ * concurrently in a thread pool. Python code itself is serialized by the
+ * GIL, but GTlab calls releasing it and waiting for I/O overlap.
+ *
+ * Concurrent scripts run off the main thread, which must not use the
+ * application or any project. The application, session and project calls of
+ * the GTlab API (e.g. init(), openProject(), currentProject(), runProcess()
+ * and close()) fail with an error in scripts of parallel jobs. Scripts that
+ * work on a project have to be run with one job.
+ */
+namespace batch
+{
+
+/**
+ * @brief The ScriptResult struct holds the result of one batch script.
+ */
+struct ScriptResult
+{
+    /// Path of the script file
+    QString file;
+
+    /// Whether the script was evaluated successfully
+    bool success{false};
+
+    /// Wall time of the evaluation in ms
+    qint64 wallTime{0};
+
+    /// Standard output of the script
+    QString output;
+
+    /// Error output of the script
+    QString errors;
+};
+
+/**
+ * @brief Returns whether the given script argument is a glob pattern, i.e.
+ * whether it contains one of the wildcards '*', '?' or '['.
+ * @param arg Script argument.
+ * @return True if the argument is a pattern.
+ */
+GT_PYTHON_EXPORT bool isPattern(const QString& arg);
+
+/**
+ * @brief Expands the given script arguments. Arguments containing the
+ * wildcards '*', '?' or '[' are treated as glob patterns of file names,
+ * which are matched in the directory of the pattern. The matches of a
+ * pattern are sorted by name.
+ * @param args Script files or patterns.
+ * @return Script files.
+ */
+GT_PYTHON_EXPORT QStringList expandScripts(const QStringList& args);
+
+/**
+ * @brief Returns whether the calling thread evaluates a script of a parallel
+ * batch run. These scripts must not use the application and project API.
+ * @return True if a script of a parallel job is evaluated.
+ */
+GT_PYTHON_EXPORT bool isParallelJob();
+
+/**
+ * @brief Evaluates the given script files in isolated batch contexts. The
+ * contexts must be initialized. If jobs is one, the scripts are evaluated
+ * one after another in the calling thread.
+ * @param files Script files to evaluate.
+ * @param jobs Maximum number of scripts evaluated concurrently.
+ * @return Results in the order of the given files.
+ */
+GT_PYTHON_EXPORT QList<ScriptResult> run(const QStringList& files, int jobs);
+
+/**
+ * @brief Returns a JSON summary of the given results. It lists the file,
+ * success, wall time, output and errors of each script as well as the
+ * number of succeeded and failed scripts.
+ * @param results Results of the batch run.
+ * @return Indented JSON document.
+ */
+GT_PYTHON_EXPORT QByteArray summary(const QList<ScriptResult>& results);
+
+} // namespace batch
+
+} // namespace gtpy
+
+#endif // GTPY_BATCHRUNNER_H
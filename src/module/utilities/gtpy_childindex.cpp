@@ -0,0 +1,243 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: gtpy_childindex.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <algorithm>
+
+#include <QHash>
+#include <QEvent>
+#include <QMutex>
+#include <QThread>
+#include <QChildEvent>
+
+#include "gtpy_childindex.h"
+
+namespace {
+
+/**
+ * Name index of the children of one parent. It lives in the thread of the
+ * parent and is only accessed from this thread.
+ */
+class ChildIndex : public QObject
+{
+public:
+    explicit ChildIndex(QObject* parent) : m_parent(parent)
+    {
+        for (auto* child : parent->children()) add(child);
+
+        parent->installEventFilter(this);
+    }
+
+    QObjectList find(const QString& name) const
+    {
+        auto retval = m_byName.value(name);
+
+        // children may have been reordered after they were added
+        if (retval.size() > 1)
+        {
+            const auto& children = m_parent->children();
+
+            std::sort(retval.begin(), retval.end(),
+                      [&children](QObject* a, QObject* b){
+                return children.indexOf(a) < children.indexOf(b);
+            });
+        }
+
+        return retval;
+    }
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override
+    {
+        if (watched == m_parent)
+        {
+            if (event->type() == QEvent::ChildAdded)
+            {
+                add(static_cast<QChildEvent*>(event)->child());
+            }
+            else if (event->type() == QEvent::ChildRemoved)
+            {
+                remove(static_cast<QChildEvent*>(event)->child());
+            }
+        }
+
+        return false;
+    }
+
+private:
+    void add(QObject* child)
+    {
+        if (m_names.contains(child)) return;
+
+        const auto name = child->objectName();
+
+        m_names.insert(child, name);
+        m_byName[name].append(child);
+
+        connect(child, &QObject::objectNameChanged, this,
+                [this, child](const QString& newName){
+            rename(child, newName);
+        }, Qt::DirectConnection);
+    }
+
+    void remove(QObject* child)
+    {
+        auto iter = m_names.find(child);
+        if (iter == m_names.end()) return;
+
+        removeName(child, iter.value());
+        m_names.erase(iter);
+
+        disconnect(child, nullptr, this, nullptr);
+    }
+
+    void rename(QObject* child, const QString& newName)
+    {
+        auto iter = m_names.find(child);
+        if (iter == m_names.end()) return;
+
+        removeName(child, iter.value());
+        iter.value() = newName;
+        m_byName[newName].append(child);
+    }
+
+    void removeName(QObject* child, const QString& name)
+    {
+        auto iter = m_byName.find(name);
+        if (iter == m_byName.end()) return;
+
+        iter->removeOne(child);
+        if (iter->isEmpty()) m_byName.erase(iter);
+    }
+
+    QObject* m_parent;
+
+    /// Children by object name
+    QHash<QString, QObjectList> m_byName;
+
+    /// Indexed object name of each child
+    QHash<QObject*, QString> m_names;
+};
+
+struct Registry
+{
+    QHash<const QObject*, ChildIndex*> indices;
+
+    bool enabled{true};
+
+    QMutex mutex;
+};
+
+// Intentionally leaked, since parents may be destroyed during shutdown
+Registry&
+registry()
+{
+    static auto* r = new Registry;
+    return *r;
+}
+
+ChildIndex*
+childIndex(const QObject* parent)
+{
+    auto& r = registry();
+
+    {
+        QMutexLocker locker(&r.mutex);
+
+        if (!r.enabled) return nullptr;
+
+        if (auto* index = r.indices.value(parent, nullptr)) return index;
+    }
+
+    if (parent->children().size() < gtpy::childindex::MIN_CHILDREN)
+    {
+        return nullptr;
+    }
+
+    // the index is only accessed from the thread of the parent, which is
+    // the current thread
+    auto* mutableParent = const_cast<QObject*>(parent);
+    auto* index = new ChildIndex(mutableParent);
+
+    QObject::connect(mutableParent, &QObject::destroyed, index, [parent](){
+        auto& r = registry();
+
+        ChildIndex* index{nullptr};
+        {
+            QMutexLocker locker(&r.mutex);
+            index = r.indices.take(parent);
+        }
+
+        delete index;
+    }, Qt::DirectConnection);
+
+    QMutexLocker locker(&r.mutex);
+    r.indices.insert(parent, index);
+
+    return index;
+}
+
+QObjectList
+linearSearch(const QObject* parent, const QString& name)
+{
+    QObjectList retval;
+
+    for (auto* child : parent->children())
+    {
+        if (child->objectName() == name) retval.append(child);
+    }
+
+    return retval;
+}
+
+} // namespace
+
+void
+gtpy::childindex::setEnabled(bool enable)
+{
+    auto& r = registry();
+
+    QList<ChildIndex*> indices;
+
+    {
+        QMutexLocker locker(&r.mutex);
+
+        r.enabled = enable;
+
+        if (!enable)
+        {
+            indices = r.indices.values();
+            r.indices.clear();
+        }
+    }
+
+    // the indices live in the threads of their parents
+    for (auto* index : qAsConst(indices)) index->deleteLater();
+}
+
+bool
+gtpy::childindex::isEnabled()
+{
+    auto& r = registry();
+
+    QMutexLocker locker(&r.mutex);
+    return r.enabled;
+}
+
+QObjectList
+gtpy::childindex::findChildren(const QObject* parent, const QString& name)
+{
+    if (!parent) return {};
+
+    if (parent->thread() == QThread::currentThread())
+    {
+        if (auto* index = childIndex(parent)) return index->find(name);
+    }
+
+    return linearSearch(parent, name);
+}
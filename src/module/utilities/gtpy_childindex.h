@@ -0,0 +1,107 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: gtpy_childindex.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#ifndef GTPY_CHILDINDEX_H
+#define GTPY_CHILDINDEX_H
+
+#include <QList>
+#include <QObject>
+#include <QString>
+
+#include "gt_pythonmodule_exports.h"
+
+namespace gtpy
+{
+
+/**
+ * Name index of the direct children of objects accessed from Python. Looking
+ * up a child by its name is linear in the number of children, which makes
+ * scripts navigating through packages with many sibling objects quadratic.
+ *
+ * The index of a parent is built on the first lookup and kept up to date
+ * when children are added, removed or renamed. Parents with less than
+ * MIN_CHILDREN children are not indexed. Lookups from a thread other than
+ * the thread of the parent fall back to a linear search, as does any lookup
+ * while the index is disabled.
+ */
+namespace childindex
+{
+
+/// Minimum number of children of an indexed parent
+constexpr int MIN_CHILDREN = 64;
+
+/**
+ * @brief Enables or disables the child index. Disabling it discards all
+ * existing indices. The index is enabled by default.
+ * @param enable True if the index should be used.
+ */
+GT_PYTHON_EXPORT void setEnabled(bool enable);
+
+/**
+ * @brief Returns whether the child index is enabled.
+ * @return True if the index is enabled.
+ */
+GT_PYTHON_EXPORT bool isEnabled();
+
+/**
+ * @brief Returns the direct children of the given parent with the given
+ * object name in the order of QObject::children().
+ * @param parent Parent object.
+ * @param name Object name of the children.
+ * @return Direct children with the given name.
+ */
+GT_PYTHON_EXPORT QObjectList findChildren(const QObject* parent,
+                                          const QString& name);
+
+/**
+ * @brief Returns the direct children of the given parent with the given
+ * object name that can be cast to T.
+ * @param parent Parent object.
+ * @param name Object name of the children.
+ * @return Direct children of type T with the given name.
+ */
+template <typename T>
+QList<T>
+findChildren(const QObject* parent, const QString& name)
+{
+    QList<T> retval;
+
+    for (auto* child : findChildren(parent, name))
+    {
+        if (auto* c = qobject_cast<T>(child)) retval.append(c);
+    }
+
+    return retval;
+}
+
+/**
+ * @brief Returns the first direct child of the given parent with the given
+ * object name that can be cast to T. It is equivalent to
+ * QObject::findChild<T>(name, Qt::FindDirectChildrenOnly).
+ * @param parent Parent object.
+ * @param name Object name of the child.
+ * @return First direct child of type T with the given name or nullptr.
+ */
+template <typename T>
+T
+findChild(const QObject* parent, const QString& name)
+{
+    for (auto* child : findChildren(parent, name))
+    {
+        if (auto* c = qobject_cast<T>(child)) return c;
+    }
+
+    return nullptr;
+}
+
+} // namespace childindex
+
+} // namespace gtpy
+
+#endif // GTPY_CHILDINDEX_H
@@ -61,6 +61,8 @@ constexpr const char* GT_INFO = "gtInfo";
 constexpr const char* GT_WARNING = "gtWarning";
 constexpr const char* GT_ERROR = "gtError";
 constexpr const char* GT_FATAL = "gtFatal";
+constexpr const char* SET_LOG_LEVEL = "setLogLevel";
+constexpr const char* LOG_LEVEL = "logLevel";
 
 } /// namespace funcs
 
@@ -68,6 +70,7 @@ namespace attrs
 {
 
 constexpr const char* LOGGING_ENABLED = "__outputToAppConsole";
+constexpr const char* LOG_LEVEL = "__logLevel";
 constexpr const char* TASK = "__task";
 
 } /// namespace attrs
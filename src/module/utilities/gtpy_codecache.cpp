@@ -0,0 +1,287 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: gtpy_codecache.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <QHash>
+#include <QList>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QCryptographicHash>
+
+#include <marshal.h>
+
+#include "gtpy_gilscope.h"
+
+#include "gtpy_codecache.h"
+
+namespace {
+
+/// Name of the compiled code. It must match the name used by PythonQt,
+/// since the line number of errors are extracted based on this name.
+constexpr const char* CODE_FILENAME = "<string>";
+
+/// Suffix of the persistent cache files
+constexpr const char* BLOB_SUFFIX = ".gtpy.pyc";
+
+struct CodeCache
+{
+    /// Owns a strong reference to each code object
+    QHash<QByteArray, PyObject*> entries;
+
+    /// Keys of the entries, ordered from least to most recently used
+    QList<QByteArray> order;
+
+    QString persistentDir;
+
+    bool persistenceEnabled{false};
+};
+
+// Intentionally leaked: the code objects must not be released after the
+// Python interpreter has been finalized.
+CodeCache&
+cache()
+{
+    static auto* c = new CodeCache;
+    return *c;
+}
+
+QByteArray
+cacheKey(const QString& code, int inputType)
+{
+    QCryptographicHash hash{QCryptographicHash::Sha1};
+    hash.addData(code.toUtf8());
+    hash.addData(QByteArray::number(inputType));
+    return hash.result().toHex();
+}
+
+QString
+blobPath(const QByteArray& key)
+{
+    const auto& dir = cache().persistentDir;
+
+    if (!cache().persistenceEnabled || dir.isEmpty()) return {};
+
+    return QDir{dir}.absoluteFilePath(QString::fromLatin1(key) + BLOB_SUFFIX);
+}
+
+QByteArray
+magicNumber()
+{
+    const long magic = PyImport_GetMagicNumber();
+
+    QByteArray retval(4, '\0');
+
+    for (int i = 0; i < 4; ++i)
+    {
+        retval[i] = static_cast<char>((magic >> (8 * i)) & 0xFF);
+    }
+
+    return retval;
+}
+
+PyPPObject
+readBlob(const QByteArray& key)
+{
+    const auto path = blobPath(key);
+    if (path.isEmpty()) return {};
+
+    QFile file{path};
+    if (!file.open(QIODevice::ReadOnly)) return {};
+
+    const auto data = file.readAll();
+    const auto magic = magicNumber();
+
+    // blobs written by other Python versions are ignored
+    if (data.size() <= magic.size() || !data.startsWith(magic)) return {};
+
+    auto code = PyPPObject::NewRef(PyMarshal_ReadObjectFromString(
+        data.constData() + magic.size(), data.size() - magic.size()));
+
+    if (!code || !PyCode_Check(code.get()))
+    {
+        PyErr_Clear();
+        return {};
+    }
+
+    return code;
+}
+
+void
+writeBlob(const QByteArray& key, const PyPPObject& code)
+{
+    const auto path = blobPath(key);
+    if (path.isEmpty()) return;
+
+    auto bytes = PyPPObject::NewRef(
+        PyMarshal_WriteObjectToString(code.get(), Py_MARSHAL_VERSION));
+
+    if (!bytes)
+    {
+        PyErr_Clear();
+        return;
+    }
+
+    if (!QDir{}.mkpath(QFileInfo{path}.absolutePath())) return;
+
+    QSaveFile file{path};
+    if (!file.open(QIODevice::WriteOnly)) return;
+
+    file.write(magicNumber());
+    file.write(PyBytes_AS_STRING(bytes.get()), PyBytes_GET_SIZE(bytes.get()));
+    file.commit();
+}
+
+void
+insert(const QByteArray& key, const PyPPObject& code)
+{
+    auto& c = cache();
+
+    QList<PyObject*> evicted;
+
+    if (auto* old = c.entries.take(key))
+    {
+        evicted.append(old);
+        c.order.removeOne(key);
+    }
+
+    while (c.order.size() >= gtpy::codecache::MAX_ENTRIES)
+    {
+        evicted.append(c.entries.take(c.order.takeFirst()));
+    }
+
+    Py_INCREF(code.get());
+    c.entries.insert(key, code.get());
+    c.order.append(key);
+
+    // release the references after the cache is consistent again
+    for (auto* obj : qAsConst(evicted)) Py_XDECREF(obj);
+}
+
+} // namespace
+
+PyPPObject
+gtpy::codecache::compile(const QString& code, int inputType)
+{
+    GTPY_GIL_SCOPE
+
+    auto& c = cache();
+    const auto key = cacheKey(code, inputType);
+
+    if (auto* obj = c.entries.value(key, nullptr))
+    {
+        c.order.removeOne(key);
+        c.order.append(key);
+        return PyPPObject::Borrow(obj);
+    }
+
+    auto codeObj = readBlob(key);
+
+    if (!codeObj)
+    {
+        codeObj = gtpy::codecache::compileUncached(code, inputType);
+
+        if (!codeObj) return {};
+
+        writeBlob(key, codeObj);
+    }
+
+    insert(key, codeObj);
+
+    return codeObj;
+}
+
+PyPPObject
+gtpy::codecache::compileUncached(const QString& code, int inputType)
+{
+    GTPY_GIL_SCOPE
+
+    // Python expects UTF-8 source code, Latin-1 would corrupt all characters
+    // beyond it
+    return PyPPObject::NewRef(Py_CompileString(
+        code.toUtf8().constData(), CODE_FILENAME, inputType));
+}
+
+void
+gtpy::codecache::invalidate(const QString& code)
+{
+    GTPY_GIL_SCOPE
+
+    auto& c = cache();
+
+    QList<PyObject*> evicted;
+
+    for (int inputType : {Py_file_input, Py_single_input})
+    {
+        const auto key = cacheKey(code, inputType);
+
+        if (auto* obj = c.entries.take(key))
+        {
+            evicted.append(obj);
+            c.order.removeOne(key);
+        }
+    }
+
+    for (auto* obj : qAsConst(evicted)) Py_XDECREF(obj);
+}
+
+void
+gtpy::codecache::clear()
+{
+    GTPY_GIL_SCOPE
+
+    auto& c = cache();
+
+    const auto evicted = c.entries.values();
+
+    c.entries.clear();
+    c.order.clear();
+
+    for (auto* obj : evicted) Py_XDECREF(obj);
+}
+
+int
+gtpy::codecache::size()
+{
+    GTPY_GIL_SCOPE
+
+    return cache().entries.size();
+}
+
+void
+gtpy::codecache::setPersistenceEnabled(bool enable)
+{
+    GTPY_GIL_SCOPE
+
+    cache().persistenceEnabled = enable;
+}
+
+bool
+gtpy::codecache::isPersistenceEnabled()
+{
+    GTPY_GIL_SCOPE
+
+    return cache().persistenceEnabled;
+}
+
+void
+gtpy::codecache::setPersistentCacheDir(const QString& dir)
+{
+    GTPY_GIL_SCOPE
+
+    cache().persistentDir = dir;
+}
+
+QString
+gtpy::codecache::persistentCacheDir()
+{
+    GTPY_GIL_SCOPE
+
+    return cache().persistentDir;
+}
@@ -0,0 +1,121 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: gtpy_codecache.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#ifndef GTPY_CODECACHE_H
+#define GTPY_CODECACHE_H
+
+#include <QString>
+
+#include "gt_pythonmodule_exports.h"
+
+#include "gtpypp.h"
+
+namespace gtpy
+{
+
+/**
+ * Per-process cache of compiled Python code objects. Scripts of Python tasks
+ * and calculators are usually evaluated many times without being changed.
+ * The cache avoids parsing and compiling them again for each evaluation.
+ *
+ * Entries are identified by a hash of the source code and the input type
+ * (Py_file_input or Py_single_input). All functions lock the GIL, which also
+ * guards the cache.
+ *
+ * The cache is only used by modules that enable it via
+ * GtpyModule::setCodeCacheEnabled(), i.e. the contexts running Python tasks
+ * and calculators. Other scripts, such as console input, are compiled
+ * without being cached.
+ */
+namespace codecache
+{
+
+/// Maximum number of code objects kept in memory
+constexpr int MAX_ENTRIES = 128;
+
+/**
+ * @brief Returns the compiled code object of the given source code. If the
+ * code was compiled before, the cached code object is returned. Otherwise,
+ * the code is loaded from the persistent cache or compiled and added to the
+ * cache.
+ * @param code Python source code.
+ * @param inputType Py_file_input or Py_single_input.
+ * @return New reference to the code object. If the compilation fails, a null
+ * object is returned and the Python error indicator is set.
+ */
+GT_PYTHON_EXPORT PyPPObject compile(const QString& code, int inputType);
+
+/**
+ * @brief Compiles the given source code without using the cache. The source
+ * code is passed to Python as UTF-8. compile() compiles through this function
+ * as well.
+ * @param code Python source code.
+ * @param inputType Py_file_input or Py_single_input.
+ * @return New reference to the code object. If the compilation fails, a null
+ * object is returned and the Python error indicator is set.
+ */
+GT_PYTHON_EXPORT PyPPObject compileUncached(const QString& code,
+                                            int inputType);
+
+/**
+ * @brief Removes the code objects of the given source code from the
+ * in-memory cache. It should be called whenever a script is replaced by a
+ * new one. Identical scripts share one entry, so another script using the
+ * same code simply compiles it again. The persistent cache is not affected:
+ * its files are named by the hash of the source code and thus never stale.
+ * @param code Python source code.
+ */
+GT_PYTHON_EXPORT void invalidate(const QString& code);
+
+/**
+ * @brief Removes all code objects from the in-memory cache. The persistent
+ * cache is not affected.
+ */
+GT_PYTHON_EXPORT void clear();
+
+/**
+ * @brief Returns the number of code objects kept in memory.
+ * @return Number of cached code objects.
+ */
+GT_PYTHON_EXPORT int size();
+
+/**
+ * @brief Enables or disables the persistent cache. If enabled, compiled code
+ * objects are written to the persistent cache directory as marshalled blobs
+ * similar to *.pyc files, so that scripts do not have to be compiled again
+ * after restarting GTlab. The persistent cache is disabled by default.
+ * @param enable True if the persistent cache should be used.
+ */
+GT_PYTHON_EXPORT void setPersistenceEnabled(bool enable);
+
+/**
+ * @brief Returns whether the persistent cache is enabled.
+ * @return True if the persistent cache is enabled.
+ */
+GT_PYTHON_EXPORT bool isPersistenceEnabled();
+
+/**
+ * @brief Sets the directory of the persistent cache. The directory is
+ * created on demand. An empty path disables writing and reading the
+ * persistent cache.
+ * @param dir Directory of the persistent cache.
+ */
+GT_PYTHON_EXPORT void setPersistentCacheDir(const QString& dir);
+
+/**
+ * @brief Returns the directory of the persistent cache.
+ * @return Directory of the persistent cache.
+ */
+GT_PYTHON_EXPORT QString persistentCacheDir();
+
+} // namespace codecache
+
+} // namespace gtpy
+
+#endif // GTPY_CODECACHE_H
@@ -0,0 +1,59 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: gtpy_completionindex.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <algorithm>
+
+#include "gtpy_completionindex.h"
+
+GtpyCompletionIndex::GtpyCompletionIndex(
+        const QMultiMap<QString, GtpyFunction>& completions)
+{
+    auto isLower = [](const QString& key){ return key == key.toLower(); };
+
+    // introspection results are keyed in lower case already, so they can
+    // usually be shared without a copy
+    if (std::all_of(completions.keyBegin(), completions.keyEnd(), isLower))
+    {
+        m_entries = completions;
+        return;
+    }
+
+    for (auto iter = completions.cbegin(); iter != completions.cend(); ++iter)
+    {
+        m_entries.insert(iter.key().toLower(), iter.value());
+    }
+}
+
+QMultiMap<QString, GtpyFunction>
+GtpyCompletionIndex::find(const QString& prefix) const
+{
+    const auto key = prefix.toLower();
+
+    QMultiMap<QString, GtpyFunction> retval;
+
+    for (auto iter = m_entries.lowerBound(key);
+         iter != m_entries.cend() && iter.key().startsWith(key); ++iter)
+    {
+        retval.insert(iter.key(), iter.value());
+    }
+
+    return retval;
+}
+
+int
+GtpyCompletionIndex::size() const
+{
+    return m_entries.size();
+}
+
+bool
+GtpyCompletionIndex::isEmpty() const
+{
+    return m_entries.isEmpty();
+}
@@ -0,0 +1,63 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: gtpy_completionindex.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#ifndef GTPY_COMPLETIONINDEX_H
+#define GTPY_COMPLETIONINDEX_H
+
+#include <QMultiMap>
+#include <QString>
+
+#include "gt_pythonmodule_exports.h"
+
+#include "gtpy_contextmanager.h"
+
+/**
+ * @brief Sorted index of the completions of a Python namespace. The keys are
+ * stored in lower case, so a case-insensitive prefix lookup is a binary
+ * search followed by a scan over the matches only.
+ */
+class GT_PYTHON_EXPORT GtpyCompletionIndex
+{
+public:
+    GtpyCompletionIndex() = default;
+
+    /**
+     * @brief Builds the index from the given completions.
+     * @param completions Completions as returned by
+     * GtpyContextManager::introspection().
+     */
+    explicit GtpyCompletionIndex(
+            const QMultiMap<QString, GtpyFunction>& completions);
+
+    /**
+     * @brief Returns all completions whose key starts with the given prefix,
+     * ignoring the case.
+     * @param prefix Prefix of the completions.
+     * @return Matching completions.
+     */
+    QMultiMap<QString, GtpyFunction> find(const QString& prefix) const;
+
+    /**
+     * @brief Returns the number of indexed completions.
+     * @return Number of indexed completions.
+     */
+    int size() const;
+
+    /**
+     * @brief Returns true if the index contains no completions.
+     * @return True if the index is empty.
+     */
+    bool isEmpty() const;
+
+private:
+    /// Completions by lower case key
+    QMultiMap<QString, GtpyFunction> m_entries;
+};
+
+#endif // GTPY_COMPLETIONINDEX_H
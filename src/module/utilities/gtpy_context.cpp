@@ -40,9 +40,6 @@ void initBatchContext(const GtpyContext& context)
 void initGlobalContext(const GtpyContext& context)
 {
     initBatchContext(context);
-
-    // TODO: Figure out why we need to run this Python code
-    context.eval("import sys\nsys.argv.append('')\ndel sys\n");
 }
 
 void initScriptEditorContext(const GtpyContext& context)
@@ -72,6 +69,74 @@ void initTaskRunContext(const GtpyContext& context)
     context.eval(gtpy::code::enableAppConsoleLogging(true));
 }
 
+/**
+ * @brief Returns true if the given global should be deep copied when the
+ * context is reset. Only mutable builtin containers are copied; modules,
+ * functions and dunder entries such as __builtins__ are shared.
+ * @param key Name of the global.
+ * @param value Value of the global.
+ * @return True if the value should be deep copied.
+ */
+bool
+isMutableGlobal(PyObject* key, PyObject* value)
+{
+    if (PyUnicode_Check(key) &&
+        PyUnicode_Tailmatch(key, PyPPObject::fromString("__").get(),
+                            0, 2, -1) == 1) return false;
+
+    return PyList_Check(value) || PyDict_Check(value) ||
+           PyAnySet_Check(value) || PyByteArray_Check(value);
+}
+
+/**
+ * @brief Returns a copy of the given globals dict. Mutable predefined
+ * values are deep copied, so that changes a script makes to them do not
+ * leak into the next run of a pooled context. Values that cannot be deep
+ * copied are shared. Expects the GIL to be held.
+ * @param dict Globals dict to copy.
+ * @return Copy of the globals dict.
+ */
+PyPPObject
+copyGlobals(const PyPPObject& dict)
+{
+    auto copy = PyPPDict_New();
+    if (!copy) return {};
+
+    PyPPObject deepcopy{};
+
+    if (auto copyModule = PyPPImport_ImportModule("copy"))
+    {
+        deepcopy = PyPPObject_GetAttr(copyModule, "deepcopy");
+    }
+
+    PyErr_Clear();
+
+    PyObject* key{nullptr};
+    PyObject* value{nullptr};
+    Py_ssize_t pos{0};
+
+    while (PyDict_Next(dict.get(), &pos, &key, &value))
+    {
+        auto item = PyPPObject::Borrow(value);
+
+        if (deepcopy && isMutableGlobal(key, value))
+        {
+            auto deep = PyPPObject::NewRef(PyObject_CallFunctionObjArgs(
+                deepcopy.get(), value, nullptr));
+
+            if (deep) item = std::move(deep);
+            else PyErr_Clear();
+        }
+
+        if (PyPPDict_SetItem(copy, PyPPObject::Borrow(key), item) != 0)
+        {
+            PyErr_Clear();
+        }
+    }
+
+    return copy;
+}
+
 void initContext(GtpyContext::ContextType type, const GtpyContext& context)
 {
     switch (type)
@@ -107,8 +172,18 @@ void initContext(GtpyContext::ContextType type, const GtpyContext& context)
 
 }
 
+struct GtpyContext::Impl
+{
+    ContextType type{DefaultContext};
+
+    // Copy of the module's __dict__ right after the initialization, see
+    // copyGlobals(). It is used to reset the context to its initial state.
+    PyPPObject initialDict{};
+};
+
 GtpyContext::GtpyContext(ContextType type) :
-    GtpyModule(QUuid::createUuid().toString())
+    GtpyModule(QUuid::createUuid().toString()),
+    m_ctx(std::make_unique<Impl>())
 {
     GTPY_GIL_SCOPE
 
@@ -125,4 +200,59 @@ GtpyContext::GtpyContext(ContextType type) :
 #endif
 
     initContext(type, *this);
+
+    m_ctx->type = type;
+
+    // task and calculator scripts are evaluated many times without changes
+    setCodeCacheEnabled(type == TaskRunContext ||
+                        type == CalculatorRunContext);
+
+    if (auto dict = PyPPModule_GetDict(module()))
+    {
+        m_ctx->initialDict = copyGlobals(dict);
+    }
+}
+
+GtpyContext::~GtpyContext()
+{
+    if (!m_ctx->initialDict) return;
+
+    GTPY_GIL_SCOPE
+
+    // The copied dict holds references to the functions added to the module,
+    // which in turn hold a reference to the module itself. It must be
+    // released before ~GtpyModule() deallocates the module.
+    PyPPDict_Clear(m_ctx->initialDict);
+    Py_XDECREF(m_ctx->initialDict.release());
+}
+
+GtpyContext::ContextType
+GtpyContext::type() const
+{
+    return m_ctx->type;
+}
+
+bool
+GtpyContext::reset()
+{
+    GTPY_GIL_SCOPE
+
+    if (!m_ctx->initialDict) return false;
+
+    auto dict = PyPPModule_GetDict(module());
+    if (!dict) return false;
+
+    PyPPDict_Clear(dict);
+
+    auto initial = copyGlobals(m_ctx->initialDict);
+
+    if (!initial || PyPPDict_Merge(dict, initial, 1) != 0)
+    {
+        PyErr_Clear();
+        return false;
+    }
+
+    setLoggingPrefix({});
+
+    return true;
 }
@@ -11,6 +11,8 @@
 #ifndef GTPYCONTEXT_H
 #define GTPYCONTEXT_H
 
+#include <memory>
+
 #include <QString>
 
 #include <gtpy_module.h>
@@ -101,6 +103,31 @@ public:
      * @param type The ContextType that defines the functionality of this context.
      */
     explicit GtpyContext(ContextType type);
+
+    ~GtpyContext() override;
+
+    /**
+     * @brief Returns the ContextType that was passed to the constructor.
+     * @return The ContextType of this context.
+     */
+    ContextType type() const;
+
+    /**
+     * @brief Resets the context to the state it had right after its
+     * construction. All variables, functions and classes defined after the
+     * construction are removed from the module's __dict__ and the predefined
+     * ones are restored. Predefined lists, dicts and sets are restored as deep
+     * copies of their initial values. The logging prefix is cleared as well.
+     *
+     * Note: Objects that are shared between modules, such as imported Python
+     * modules, are not reset.
+     * @return True if the context was successfully reset, otherwise false.
+     */
+    bool reset();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_ctx;
 };
 
 #endif // GTPYCONTEXT_H
@@ -19,8 +19,18 @@
 #include <QMetaMethod>
 #include <QMetaEnum>
 #include <QDir>
+#include <QFileInfo>
 #include <QThreadPool>
 #include <QRegularExpression>
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QPointer>
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
 
 #include "PythonQt.h"
 #include "PythonQtObjectPtr.h"
@@ -51,6 +61,7 @@
 #include "gtpy_importfunction.h"
 #include "gtpy_calculatorsmodule.h"
 #include "gtpy_utils.h"
+#include "gtpy_codecache.h"
 
 #if GT_VERSION >= GT_VERSION_CHECK(2, 0, 0)
 #include "gtpy_matplotlib.h"
@@ -63,6 +74,130 @@
 namespace
 {
 
+/// Minimum time between two flushes of the output of a thread in ms
+constexpr qint64 OUTPUT_FLUSH_INTERVAL = 50;
+
+/// Size of the pending output of a thread that forces a flush
+constexpr int OUTPUT_FLUSH_SIZE = 4096;
+
+/**
+ * Output of a thread that has not been emitted yet. It is shared between the
+ * thread and the output timer of the context manager, which flushes it if
+ * the thread does not write again (e.g. during a long running statement).
+ */
+struct OutputBuffer
+{
+    /// Guards all members
+    QMutex mutex;
+
+    /// Output that has not been emitted yet
+    QString pending;
+
+    /// Context the pending output belongs to
+    int contextId{-1};
+
+    /// Time since the last flush
+    QElapsedTimer sinceFlush;
+};
+
+/**
+ * Output buffers of all threads. Buffers of finished threads are removed by
+ * the output timer once they are flushed.
+ */
+struct OutputBuffers
+{
+    QMutex mutex;
+    QList<std::shared_ptr<OutputBuffer>> buffers;
+
+    /// Whether the output timer is started or about to be started
+    std::atomic<bool> timerActive{false};
+};
+
+// Intentionally leaked, threads may still write during shutdown
+OutputBuffers&
+outputBuffers()
+{
+    static auto* buffers = new OutputBuffers;
+    return *buffers;
+}
+
+/**
+ * Output state of a thread. It mirrors the meta data of the thread dict, so
+ * that the stdout/stderr redirection does not have to look it up for each
+ * message.
+ */
+struct ThreadOutput
+{
+    /// Whether a context is set for the thread
+    bool hasContext{false};
+    int contextId{-1};
+    bool output{false};
+    bool error{false};
+
+    /// Output buffer of the thread. Created on the first output.
+    std::shared_ptr<OutputBuffer> buffer;
+};
+
+thread_local ThreadOutput t_output;
+
+OutputBuffer&
+threadBuffer(ThreadOutput& t)
+{
+    if (!t.buffer)
+    {
+        t.buffer = std::make_shared<OutputBuffer>();
+
+        auto& all = outputBuffers();
+        QMutexLocker locker{&all.mutex};
+        all.buffers.append(t.buffer);
+    }
+
+    return *t.buffer;
+}
+
+/**
+ * @brief Takes the pending output of the given buffer.
+ * @param buffer Output buffer.
+ * @param message Taken output.
+ * @param contextId Context the output belongs to.
+ * @param minAge If not negative, the output is only taken if the last flush
+ * of the buffer is at least minAge ms ago.
+ * @return True if output was taken.
+ */
+bool
+takePending(OutputBuffer& buffer, QString& message, int& contextId,
+            qint64 minAge = -1)
+{
+    QMutexLocker locker{&buffer.mutex};
+
+    if (buffer.pending.isEmpty()) return false;
+
+    if (minAge >= 0 && buffer.sinceFlush.isValid() &&
+        buffer.sinceFlush.elapsed() < minAge) return false;
+
+    std::swap(message, buffer.pending);
+    contextId = buffer.contextId;
+    buffer.sinceFlush.start();
+
+    return true;
+}
+
+void
+emitOutput(const QString& message, int contextId)
+{
+    auto* mgr = GtpyContextManager::instance();
+
+    if (!mgr)
+    {
+        std::cout << message.toLatin1().data() << std::flush;
+        return;
+    }
+
+    auto prefix = mgr->loggingPrefix(contextId);
+
+    emit mgr->pythonMessage(message, contextId, prefix);
+}
+
 GtpyContext::ContextType contextTypeEnumConvert(
         GtpyContextManager::Context type)
 {
@@ -132,6 +267,14 @@ GtpyContextManager::GtpyContextManager(QObject* parent) :
     qRegisterMetaType<GtpyContextManager::Context>
         ("GtpyContextManager::Context");
 
+    m_contextPool.setCapacity(GtpyContext::TaskRunContext, 2);
+    m_contextPool.setCapacity(GtpyContext::CalculatorRunContext, 2);
+
+    m_outputTimer = new QTimer(this);
+    m_outputTimer->setInterval(OUTPUT_FLUSH_INTERVAL);
+    connect(m_outputTimer, &QTimer::timeout, this,
+            &GtpyContextManager::flushPendingOutput);
+
 #if GT_VERSION < GT_VERSION_CHECK(2, 0, 0)
     setEnvironmentPaths();
 #endif
@@ -200,6 +343,9 @@ GtpyContextManager::GtpyContextManager(QObject* parent) :
 
     connect(gtApp, &GtCoreApplication::currentProjectChanged, this,
             &GtpyContextManager::onProjectChanged);
+
+    connect(&m_moduleScanner, &GtpyModuleScanner::modulesChanged, this,
+            &GtpyContextManager::setImportableModulesCompletions);
 }
 
 GtpyContextManager*
@@ -213,12 +359,16 @@ GtpyContextManager::instance()
 
 GtpyContextManager::~GtpyContextManager()
 {
+    // pooled contexts must be destroyed before the interpreter is finalized
+    m_contextPool.shutdown();
+
     if (m_pyThreadState != nullptr)
     {
         PyEval_RestoreThread(m_pyThreadState);
     }
 
     m_contextMap.clear();
+    m_pendingContexts.clear();
 
     PythonQt::cleanup();
 }
@@ -344,7 +494,28 @@ GtpyContextManager::initExtensions()
     initCalculatorsModule();
     initImportBehaviour();
 
+    // the embedded interpreter may start without sys.argv or with an empty
+    // one, but modules like argparse, tkinter and matplotlib read
+    // sys.argv[0] and fail. An empty script name is what the interactive
+    // interpreter sets. sys.argv is shared by all contexts, so it is set
+    // once here instead of by every new global context.
+    auto argv = PyPPSys_GetObject("argv");
+
+    if (!argv || !PyList_Check(argv.get()))
+    {
+        argv = PyPPObject::NewRef(PyList_New(0));
+        PySys_SetObject("argv", argv.get());
+    }
+
+    if (PyPPList_Size(argv) == 0)
+    {
+        PyPPList_Append(argv, PyPPObject::fromString(""));
+    }
+
     addCollectionPaths();
+
+    // scan for importable modules before the first completion is requested
+    updateModulePaths();
 }
 
 bool
@@ -375,6 +546,8 @@ GtpyContextManager::evalScript(int contextId,
         success = con->eval(script, evalOptEnumConvert(option));
     }
 
+    flushStdOut();
+
     if (output || (!success && errorMessage))
     {
         emit scriptEvaluated(contextId);
@@ -383,6 +556,30 @@ GtpyContextManager::evalScript(int contextId,
     return success;
 }
 
+GtpyScriptRunnable*
+GtpyContextManager::evalScriptAsync(int contextId, const QString& script,
+                                    QObject* receiver,
+                                    std::function<void(bool)> finished,
+                                    const bool output,
+                                    const EvalOptions& option)
+{
+    auto* runnable = new GtpyScriptRunnable(contextId);
+    runnable->setScript(script);
+    runnable->setOutputToConsole(output);
+    runnable->setEvalOption(option);
+    runnable->setAutoDelete(false);
+
+    // connect before the start, the evaluation may finish immediately
+    connect(runnable, &GtpyScriptRunnable::runnableFinished, receiver,
+            [runnable, finished](){
+        if (finished) finished(runnable->successful());
+    }, Qt::QueuedConnection);
+
+    QThreadPool::globalInstance()->start(runnable);
+
+    return runnable;
+}
+
 QMultiMap<QString, GtpyFunction>
 GtpyContextManager::introspection(int contextId, const QString& objectname,
                                   const bool appendModules)
@@ -396,15 +593,6 @@ GtpyContextManager::introspection(int contextId, const QString& objectname,
 
     const bool objNameIsEmpty = objectname.isEmpty();
 
-    static bool standardCompletionsSet = false;
-
-    if (!standardCompletionsSet)
-    {
-        setStandardCompletions(contextId);
-        setImportableModulesCompletions(contextId);
-        standardCompletionsSet = true;
-    }
-
     PyPPObject object;
 
     if (objNameIsEmpty)
@@ -423,33 +611,33 @@ GtpyContextManager::introspection(int contextId, const QString& objectname,
     }
     else
     {
-        QString temp = QStringLiteral("obj");
-        QString script = temp + QStringLiteral(" = ") + objectname;
+        // the expression is evaluated without assigning its result, so that
+        // the namespace of the context is not modified
+        auto globals = PyPPModule_GetDict(con->module());
 
-        bool eval = evalScript(contextId, script, false, false,
-                               EvalSingleString);
+        object = PyPPObject::NewRef(PyRun_String(
+            objectname.toLatin1().constData(), Py_eval_input,
+            globals.get(), globals.get()));
 
-        if (eval)
+        if (object)
         {
-            object = PyPPObject::Borrow(
-                PythonQt::self()->lookupObject(con->module().get(), temp));
-
-            if (object)
-            {
-                results = introspectObject(object.get());
-            }
-
-            con->removeVariable(temp);
+            results = introspectObject(object.get());
+        }
+        else
+        {
+            PyErr_Clear();
         }
     }
 
     if (objNameIsEmpty)
     {
+        // set once by initContexts(), so it is read without a lock
         results = results + calculatorCompletions(contextId) +
                   m_standardCompletions;
 
         if (appendModules)
         {
+            QMutexLocker locker{&m_completionsMutex};
             results += m_importableModulesCompletions;
         }
     }
@@ -477,17 +665,20 @@ GtpyContextManager::addObject(int contextId,
     auto con = context(contextId);
     if (!con) return false;
 
-    QStringList list = m_addedObjectNames.value(contextId, QStringList());
-
-    if (list.contains(name))
     {
-        return false;
-    }
+        QWriteLocker locker{&m_contextLock};
 
-    if (saveName)
-    {
-        list.append(name);
-        m_addedObjectNames.insert(contextId, list);
+        QStringList& list = m_addedObjectNames[contextId];
+
+        if (list.contains(name))
+        {
+            return false;
+        }
+
+        if (saveName)
+        {
+            list.append(name);
+        }
     }
 
     con->addObject(name, obj);
@@ -514,17 +705,20 @@ GtpyContextManager::addGtObject(int contextId, const QString& name,
     auto con = context(contextId);
     if (!con) return false;
 
-    QStringList list = m_addedObjectNames.value(contextId, QStringList());
-
-    if (list.contains(name))
     {
-        return false;
-    }
+        QWriteLocker locker{&m_contextLock};
 
-    if (saveName)
-    {
-        list.append(name);
-        m_addedObjectNames.insert(contextId, list);
+        QStringList& list = m_addedObjectNames[contextId];
+
+        if (list.contains(name))
+        {
+            return false;
+        }
+
+        if (saveName)
+        {
+            list.append(name);
+        }
     }
 
     auto argsTuple = PyPPTuple_New(1);
@@ -580,11 +774,13 @@ GtpyContextManager::removeObject(int contextId, const QString& name)
 {
     GTPY_GIL_SCOPE
 
-    QStringList list = m_addedObjectNames.value(contextId, QStringList());
-
-    if (!list.contains(name))
     {
-        return false;
+        QReadLocker locker{&m_contextLock};
+
+        if (!m_addedObjectNames.value(contextId).contains(name))
+        {
+            return false;
+        }
     }
 
     auto con = context(contextId);
@@ -592,9 +788,9 @@ GtpyContextManager::removeObject(int contextId, const QString& name)
 
     con->removeVariable(name);
 
-    list.removeOne(name);
+    QWriteLocker locker{&m_contextLock};
 
-    m_addedObjectNames.insert(contextId, list);
+    m_addedObjectNames[contextId].removeOne(name);
 
     return true;
 }
@@ -607,15 +803,20 @@ GtpyContextManager::removeAllAddedObjects(int contextId)
     auto con = context(contextId);
     if (!con) return false;
 
-    QStringList list = m_addedObjectNames.value(contextId, QStringList());
+    QStringList list;
+
+    {
+        QWriteLocker locker{&m_contextLock};
+
+        list = m_addedObjectNames.value(contextId);
+        m_addedObjectNames.insert(contextId, QStringList());
+    }
 
     foreach (QString objName, list)
     {
         con->removeVariable(objName);
     }
 
-    m_addedObjectNames.insert(contextId, QStringList());
-
     return true;
 }
 
@@ -624,7 +825,7 @@ GtpyContextManager::addTaskValue(int contextId, GtTask* task)
 {
     GTPY_GIL_SCOPE
 
-    if (!m_calcAccessibleContexts.contains(contextId))
+    if (!isCalcAccessible(contextId))
     {
         return false;
     }
@@ -641,13 +842,21 @@ GtpyContextManager::addTaskValue(int contextId, GtTask* task)
         evalScript(contextId, pyCode, false);
     }
 
+    // calculators created in the context find their parent task without
+    // walking through the call stack
+    if (auto con = context(contextId))
+    {
+        GtpyCalculatorsModule::setContextTask(
+            PyPPModule_GetDict(con->module()).get(), task);
+    }
+
     return true;
 }
 
 void
 GtpyContextManager::deleteCalcsFromTask(int contextId)
 {
-    if (!m_calcAccessibleContexts.contains(contextId))
+    if (!isCalcAccessible(contextId))
     {
         return;
     }
@@ -681,7 +890,7 @@ GtpyContextManager::setPropertyValueFuncName() const
 void
 GtpyContextManager::setLoggingPrefix(int contextId, const QString &prefix)
 {
-    GtpyContext* ctx = context(contextId);
+    auto ctx = context(contextId);
     if (!ctx)
     {
         gtError() << QObject::tr("Invalid contextId in "
@@ -694,7 +903,7 @@ GtpyContextManager::setLoggingPrefix(int contextId, const QString &prefix)
 
 QString GtpyContextManager::loggingPrefix(int contextId) const
 {
-    GtpyContext const* ctx = context(contextId);
+    auto ctx = context(contextId);
     if (!ctx)
     {
         gtError() << QObject::tr("Invalid contextId in "
@@ -718,21 +927,27 @@ GtpyContextManager::initContexts()
 
     int keyCount = metaEnum.keyCount();
 
-    for (int i = 0;  i < keyCount; i++)
     {
-        auto type = contextTypeEnumConvert(
-            static_cast<Context>(metaEnum.value(i)));
+        QWriteLocker locker{&m_contextLock};
+
+        // the system contexts are created on first access by context()
+        for (int i = 0;  i < keyCount; i++)
+        {
+            int contextId = metaEnum.value(i);
 
-        int contextId = metaEnum.value(i);
+            if (m_contextMap.contains(contextId)) continue;
 
-        m_contextMap.insert(contextId, std::make_shared<GtpyContext>(type));
+            m_pendingContexts.insert(contextId);
 
-        if (type == GtpyContext::TaskEditorContext ||
-            type == GtpyContext::TaskRunContext)
-        {
-            if (!m_calcAccessibleContexts.contains(contextId))
+            auto type = contextTypeEnumConvert(static_cast<Context>(contextId));
+
+            if (type == GtpyContext::TaskEditorContext ||
+                type == GtpyContext::TaskRunContext)
             {
-                m_calcAccessibleContexts << contextId;
+                if (!m_calcAccessibleContexts.contains(contextId))
+                {
+                    m_calcAccessibleContexts << contextId;
+                }
             }
         }
     }
@@ -741,30 +956,45 @@ GtpyContextManager::initContexts()
     // Otherwise, python will take care of it
     if (m_ownsPythonInterpreter) initStdOut();
 
+    // completers read them in their own threads afterwards
+    setStandardCompletions();
+
     m_contextsInitialized = true;
+
+    // the extensions are initialized now, so the pool can be warmed up
+    m_contextPool.setRefillEnabled(true);
 }
 
 int
 GtpyContextManager::createNewContext(const GtpyContextManager::Context& type,
                                      bool emitSignal)
 {
-    auto keys = m_contextMap.keys();
-
-    // We let user contexts start from 100 to have room for system contexts
-    int contextId = keys.isEmpty() ? 100 :
-                        *std::max_element(keys.begin(), keys.end()) + 1;
     auto contextType = contextTypeEnumConvert(type);
 
-    m_contextMap.insert(contextId, std::make_shared<GtpyContext>(contextType));
+    // the context is acquired outside of the lock, since it requires the GIL
+    auto con = m_contextPool.acquire(contextType);
+
+    int contextId = -1;
 
-    if ((contextType == GtpyContext::TaskEditorContext ||
-         contextType == GtpyContext::TaskRunContext ) &&
-        !m_calcAccessibleContexts.contains(contextId))
     {
-        m_calcAccessibleContexts << contextId;
-    }
+        QWriteLocker locker{&m_contextLock};
+
+        // We let user contexts start from 100 to have room for system
+        // contexts, which may not be created yet
+        contextId = m_contextMap.isEmpty() ?
+                        100 : qMax(100, m_contextMap.lastKey() + 1);
+
+        m_contextMap.insert(contextId, std::move(con));
+
+        if ((contextType == GtpyContext::TaskEditorContext ||
+             contextType == GtpyContext::TaskRunContext ) &&
+            !m_calcAccessibleContexts.contains(contextId))
+        {
+            m_calcAccessibleContexts << contextId;
+        }
 
-    m_addedObjectNames.insert(contextId, {});
+        m_addedObjectNames.insert(contextId, {});
+    }
 
     if (emitSignal)
     {
@@ -777,18 +1007,57 @@ GtpyContextManager::createNewContext(const GtpyContextManager::Context& type,
 bool
 GtpyContextManager::deleteContext(int contextId, bool emitSignal)
 {
-    m_contextMap.take(contextId);
+    std::shared_ptr<GtpyContext> con;
+
+    {
+        QWriteLocker locker{&m_contextLock};
+
+        con = m_contextMap.take(contextId);
+        m_calcAccessibleContexts.removeOne(contextId);
+        m_pendingContexts.remove(contextId);
+    }
+
+    if (con)
+    {
+        GTPY_GIL_SCOPE
+
+        // pooled contexts keep their globals dict
+        GtpyCalculatorsModule::setContextTask(
+            PyPPModule_GetDict(con->module()).get(), nullptr);
+    }
+
+    // the context is released outside of the lock, since it requires the GIL
+    m_contextPool.release(std::move(con));
 
     if (emitSignal)
     {
         emit contextDeleted(contextId);
     }
 
-    m_calcAccessibleContexts.removeOne(contextId);
-
     return true;
 }
 
+void
+GtpyContextManager::setContextPoolSize(const GtpyContextManager::Context& type,
+                                       int size)
+{
+    m_contextPool.setCapacity(contextTypeEnumConvert(type), size);
+}
+
+int
+GtpyContextManager::contextPoolSize(
+        const GtpyContextManager::Context& type) const
+{
+    return m_contextPool.capacity(contextTypeEnumConvert(type));
+}
+
+GtpyContextPool::Statistics
+GtpyContextManager::contextPoolStatistics(
+        const GtpyContextManager::Context& type) const
+{
+    return m_contextPool.statistics(contextTypeEnumConvert(type));
+}
+
 void
 GtpyContextManager::resetContext(const GtpyContextManager::Context& type,
                                  int contextId)
@@ -800,7 +1069,16 @@ GtpyContextManager::resetContext(const GtpyContextManager::Context& type,
 
     auto contextType = contextTypeEnumConvert(type);
 
-    m_contextMap.insert(contextId, std::make_shared<GtpyContext>(contextType));
+    // the contexts are created and destroyed outside of the lock, since both
+    // require the GIL
+    auto con = std::make_shared<GtpyContext>(contextType);
+    std::shared_ptr<GtpyContext> old;
+
+    QWriteLocker locker{&m_contextLock};
+
+    old = m_contextMap.take(contextId);
+    m_contextMap.insert(contextId, std::move(con));
+    m_pendingContexts.remove(contextId);
 
     if (contextType == GtpyContext::TaskEditorContext ||
         contextType == GtpyContext::TaskRunContext)
@@ -912,16 +1190,68 @@ GtpyContextManager::createCustomModule(
     return !PythonQt::self()->hadError();
 }
 
-GtpyContext const *
+std::shared_ptr<const GtpyContext>
 GtpyContextManager::context(int contextId) const
 {
-    return m_contextMap.value(contextId, nullptr).get();
+    // system contexts are created on first access, even by const accessors
+    return const_cast<GtpyContextManager*>(this)->context(contextId);
 }
 
-GtpyContext *
+std::shared_ptr<GtpyContext>
 GtpyContextManager::context(int contextId)
 {
-    return m_contextMap.value(contextId, nullptr).get();
+    {
+        QReadLocker locker{&m_contextLock};
+
+        auto iter = m_contextMap.constFind(contextId);
+        if (iter != m_contextMap.constEnd()) return *iter;
+
+        if (!m_pendingContexts.contains(contextId)) return nullptr;
+    }
+
+    return createSystemContext(contextId);
+}
+
+std::shared_ptr<GtpyContext>
+GtpyContextManager::createSystemContext(int contextId)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // the context is created outside of the lock, since it requires the GIL.
+    // If another thread was faster, it is destroyed after the lock is
+    // released.
+    auto con = std::make_shared<GtpyContext>(
+        contextTypeEnumConvert(static_cast<Context>(contextId)));
+
+    {
+        QWriteLocker locker{&m_contextLock};
+
+        if (!m_pendingContexts.remove(contextId))
+        {
+            return m_contextMap.value(contextId, nullptr);
+        }
+
+        m_contextMap.insert(contextId, con);
+    }
+
+    QMetaObject metaObj = GtpyContextManager::staticMetaObject;
+    QMetaEnum metaEnum = metaObj.enumerator(
+        metaObj.indexOfEnumerator("Context"));
+
+    gtDebug().medium() << "Created Python context"
+                       << metaEnum.valueToKey(contextId)
+                       << "in" << timer.elapsed() << "ms";
+
+    return con;
+}
+
+bool
+GtpyContextManager::isCalcAccessible(int contextId) const
+{
+    QReadLocker locker{&m_contextLock};
+
+    return m_calcAccessibleContexts.contains(contextId);
 }
 
 
@@ -1005,8 +1335,9 @@ GtpyContextManager::initLoggingModuleC()
 {
     GTPY_GIL_SCOPE
 
-    initExtensionModule(gtpy::code::modules::GT_LOGGING,
-                        &GtpyLoggingModule::GtpyLogging_Module);
+    auto module = initExtensionModule(gtpy::code::modules::GT_LOGGING,
+                                      &GtpyLoggingModule::GtpyLogging_Module);
+    GtpyLoggingModule::addLogLevels(module.get());
 }
 
 void
@@ -1052,10 +1383,12 @@ GtpyContextManager::initStdOut()
     m_out = GtpyStdOutRedirect_Type.tp_new(&GtpyStdOutRedirect_Type, NULL,
                                            NULL);
     ((GtpyStdOutRedirect*)m_out.object())->callback = stdOutRedirectCB;
+    ((GtpyStdOutRedirect*)m_out.object())->flushCallback = flushStdOut;
 
     m_err = GtpyStdOutRedirect_Type.tp_new(&GtpyStdOutRedirect_Type, NULL,
                                            NULL);
     ((GtpyStdOutRedirect*)m_err.object())->callback = stdErrRedirectCB;
+    ((GtpyStdOutRedirect*)m_err.object())->flushCallback = flushStdOut;
 
     // replace the built in file objects with the new objects
     PyModule_AddObject(sys, "stdout", m_out);
@@ -1145,6 +1478,9 @@ GtpyContextManager::setMetaDataToThreadDict(const gtpy::StdOutMetaData& mData)
 {
     GTPY_GIL_SCOPE
 
+    // pending output belongs to the previous meta data
+    flushStdOut();
+
     auto threadDict = PyPPThreadState_GetDict();
 
     if (!threadDict)
@@ -1152,6 +1488,12 @@ GtpyContextManager::setMetaDataToThreadDict(const gtpy::StdOutMetaData& mData)
         return;
     }
 
+    t_output.hasContext = !mData.contextName.isEmpty();
+    t_output.contextId = t_output.hasContext ?
+                contextIdByName(mData.contextName) : -1;
+    t_output.output = mData.output;
+    t_output.error = mData.error;
+
     {
         const auto key = PyPPObject::fromQString(mData.contextName);
         PyPPDict_SetItem(threadDict, gtpy::code::keys::CONTEXT, key);
@@ -1182,18 +1524,85 @@ void
 GtpyContextManager::addModulePath(const QString& path)
 {
     gtpy::utils::addToSysPath(path);
+
+    updateModulePaths();
+}
+
+void
+GtpyContextManager::updateModulePaths()
+{
+    QStringList paths;
+
+    {
+        GTPY_GIL_SCOPE
+
+        auto pyPath = PyPPSys_GetObject("path");
+
+        for (Py_ssize_t i = 0; pyPath && i < PyPPList_Size(pyPath); ++i)
+        {
+            auto item = PyPPList_GetItem(pyPath, i);
+            if (PyUnicode_Check(item.get()) && PyUnicode_GetLength(item.get()))
+            {
+                paths.append(PyPPString_AsQString(item));
+            }
+        }
+
+        if (m_builtinModules.isEmpty())
+        {
+            auto names = PyPPSys_GetObject("builtin_module_names");
+
+            for (Py_ssize_t i = 0; names && i < PyPPTuple_Size(names); ++i)
+            {
+                m_builtinModules.append(
+                            PyPPString_AsQString(PyPPTuple_GetItem(names, i)));
+            }
+        }
+    }
+
+    // the scanner and the watcher belong to the thread of the manager
+    QMetaObject::invokeMethod(this, [this, paths](){
+        m_moduleScanner.setPaths(paths);
+
+        const auto watched = m_watcher.directories();
+
+        for (const auto& path : paths)
+        {
+            if (!watched.contains(path) && QFileInfo{path}.isDir())
+            {
+                m_watcher.addPath(path);
+            }
+        }
+    });
 }
 
 
 bool GtpyContextManager::initMatplotlib()
 {
 #if GT_VERSION >= GT_VERSION_CHECK(2, 0, 0)
-    gtDebug() << "Initializing Matplotlib backend";
-    if (!createCustomModule(gtpy::matplotlib::backendName,
-                            gtpy::matplotlib::customBackend)) return false;
+    QElapsedTimer timer;
+    timer.start();
+
+    // matplotlib itself is imported when the user code imports it
+    if (!createCustomModule(gtpy::matplotlib::hookName,
+                            gtpy::matplotlib::lazyBackendHook)) return false;
+
+    {
+        GTPY_GIL_SCOPE
+
+        auto hook = PyPPImport_ImportModule(gtpy::matplotlib::hookName);
+        if (!hook) return false;
+
+        auto result = PyPPObject_CallMethod(hook, "install", "s",
+                                            gtpy::matplotlib::customBackend);
+        if (!result)
+        {
+            PyErr_Print();
+            return false;
+        }
+    }
 
-    if (!evalScript(GtpyContextManager::GlobalContext,
-                    gtpy::matplotlib::setCustomBackend)) return false;
+    gtDebug().medium() << "Matplotlib backend registered in"
+                       << timer.elapsed() << "ms";
 #endif
 
     return true;
@@ -1595,36 +2004,28 @@ GtpyContextManager::customCompletions() const
 }
 
 QMultiMap<QString, GtpyFunction>
-GtpyContextManager::builtInCompletions(int contextId) const
+GtpyContextManager::builtInCompletions() const
 {
     GTPY_GIL_SCOPE
 
     QMultiMap<QString, GtpyFunction> results;
 
-    // the script down below does not work in 2.7
+    // the lookup down below does not work in 2.7
     if (pythonVersion() != QStringLiteral("3.7"))
     {
         return results;
     }
 
-    auto con = context(contextId);
-    if (!con) return results;
-
-    con->eval(QStringLiteral("import inspect"));
-    con->eval(QStringLiteral("def __builtins():") +
-                   QStringLiteral("return dir(inspect.builtins)"));
-
-    auto tmpPythonQtPtr = PythonQtObjectPtr{con->module().get()};
-    QVariant v = tmpPythonQtPtr.call(QStringLiteral("__builtins"));
-
-    con->eval(QStringLiteral("del inspect"));
+    auto builtins = PyPPImport_ImportModule("builtins");
 
-    if (v.isNull())
+    if (!builtins)
     {
+        PyErr_Clear();
         return results;
     }
 
-    QStringList builtinFunctions = v.toStringList();
+    QStringList builtinFunctions = PythonQtConv::PyObjToQVariant(
+        PyPPObject_Dir(builtins).get()).toStringList();
 
     foreach (QString name, builtinFunctions)
     {
@@ -1653,43 +2054,14 @@ GtpyContextManager::builtInCompletions(int contextId) const
 }
 
 void
-GtpyContextManager::setImportableModulesCompletions(int contextId)
+GtpyContextManager::setImportableModulesCompletions()
 {
-    GTPY_GIL_SCOPE
-
-    // the script down below does not work in 2.7
-    if (pythonVersion() != QStringLiteral("3.7"))
-    {
-        return;
-    }
-
     QMultiMap<QString, GtpyFunction> results;
 
-    auto con = context(contextId);
-    if (!con) return;
-
-    con->eval(QStringLiteral("import pkgutil"));
-    con->eval(QStringLiteral("def __importableModules():\n") +
-                   QStringLiteral("\tmodules = pkgutil.iter_modules()\n") +
-                   QStringLiteral("\tx = (i.name for i in modules)\n") +
-                   QStringLiteral("\treturn list(x)"));
-
-    auto tmpPythonQtPtr = PythonQtObjectPtr{con->module().get()};
-    QVariant v = tmpPythonQtPtr.call(QStringLiteral("__importableModules"));
-
-    con->eval(QStringLiteral("del pkgutil"));
-
-    if (v.isNull())
-    {
-        return;
-    }
-
-    QStringList modules = v.toStringList();
+    auto modules = m_moduleScanner.modules() + m_builtinModules;
+    modules.removeDuplicates();
 
-    modules.append(QStringLiteral("sys"));  // sys is somehow not listed
-    modules.append(QStringLiteral("time")); // time is somehow not listed
-
-    foreach (QString name, modules)
+    for (const auto& name : qAsConst(modules))
     {
         if (name.startsWith(QStringLiteral("_")))
         {
@@ -1716,6 +2088,7 @@ GtpyContextManager::setImportableModulesCompletions(int contextId)
         results.insert(fromModule, fromModuleImport);
     }
 
+    QMutexLocker locker{&m_completionsMutex};
     m_importableModulesCompletions = results;
 }
 
@@ -1724,7 +2097,7 @@ GtpyContextManager::calculatorCompletions(int contextId) const
 {
     QMultiMap<QString, GtpyFunction> results;
 
-    if (!m_calcAccessibleContexts.contains(contextId))
+    if (!isCalcAccessible(contextId))
     {
         return results;
     }
@@ -1755,9 +2128,9 @@ GtpyContextManager::calculatorCompletions(int contextId) const
 }
 
 void
-GtpyContextManager::setStandardCompletions(int contextId)
+GtpyContextManager::setStandardCompletions()
 {
-    QMultiMap<QString, GtpyFunction> results = builtInCompletions(contextId);
+    QMultiMap<QString, GtpyFunction> results = builtInCompletions();
     QMultiMap<QString, GtpyFunction> customs = customCompletions();
 
     foreach (QString name, customs.keys()) // remove duplicates (mainly print)
@@ -1818,9 +2191,7 @@ GtpyContextManager::pythonVersion() const
 }
 
 void
-GtpyContextManager::stdOutRedirectCB(const QString& contextName,
-                                     const bool output, const bool /*error*/,
-                                     const QString& message)
+GtpyContextManager::stdOutRedirectCB(const QString& message)
 {
     if (!GtpyContextManager::instance())
     {
@@ -1828,37 +2199,59 @@ GtpyContextManager::stdOutRedirectCB(const QString& contextName,
         return;
     }
 
-    if (output && !contextName.isEmpty())
+    auto& t = t_output;
+
+    if (!t.output || !t.hasContext)
     {
-        int contextId = GtpyContextManager::instance()->
-                        contextIdByName(contextName);
+        return;
+    }
 
-        if (contextId == BatchContext)
+    if (t.contextId == BatchContext)
+    {
+        if (message.indexOf(QStringLiteral("\n")) != 0 &&
+            !message.isEmpty())
         {
-            if (message.indexOf(QStringLiteral("\n")) != 0 &&
-                !message.isEmpty())
-            {
-                std::cout << message.toLatin1().data() << std::endl;
-            }
-
-            return;
+            std::cout << message.toLatin1().data() << std::endl;
         }
 
-        auto prefix = GtpyContextManager::instance()->loggingPrefix(contextId);
+        return;
+    }
+
+    auto& buffer = threadBuffer(t);
 
-        emit GtpyContextManager::instance()->pythonMessage(message, contextId, prefix);
+    bool flush{false};
+    bool wasEmpty{false};
+
+    {
+        QMutexLocker locker{&buffer.mutex};
+
+        wasEmpty = buffer.pending.isEmpty();
+
+        if (wasEmpty) buffer.contextId = t.contextId;
+
+        buffer.pending += message;
+
+        bool lineBreak = message.contains(QLatin1Char('\n'));
+
+        flush = buffer.pending.size() >= OUTPUT_FLUSH_SIZE ||
+                (lineBreak && (!buffer.sinceFlush.isValid() ||
+                               buffer.sinceFlush.elapsed() >=
+                                   OUTPUT_FLUSH_INTERVAL));
     }
 
-    //    else
-    //    {
-    //        std::cout << message.toLatin1().data() << std::endl;
-    //    }
+    if (flush)
+    {
+        flushStdOut();
+    }
+    else if (wasEmpty)
+    {
+        // the output timer flushes the output if nothing else is written
+        startOutputTimer();
+    }
 }
 
 void
-GtpyContextManager::stdErrRedirectCB(const QString& contextName,
-                                     const bool /*output*/, const bool error,
-                                     const QString& message)
+GtpyContextManager::stdErrRedirectCB(const QString& message)
 {
     if (!GtpyContextManager::instance())
     {
@@ -1866,11 +2259,14 @@ GtpyContextManager::stdErrRedirectCB(const QString& contextName,
         return;
     }
 
-    if (error && !contextName.isEmpty())
-    {
-        int contextId = GtpyContextManager::instance()->
-                        contextIdByName(contextName);
+    // keep the order of output and error messages
+    flushStdOut();
 
+    auto& t = t_output;
+
+    if (t.error && t.hasContext)
+    {
+        int contextId = t.contextId;
 
         auto prefix = GtpyContextManager::instance()->loggingPrefix(contextId);
         emit GtpyContextManager::instance()->errorMessage(message, contextId, prefix);
@@ -1882,28 +2278,116 @@ GtpyContextManager::stdErrRedirectCB(const QString& contextName,
             emit GtpyContextManager::instance()->errorCodeLine(line, contextId);
         }
     }
+}
+
+void
+GtpyContextManager::flushStdOut()
+{
+    auto& t = t_output;
+
+    if (!t.buffer)
+    {
+        return;
+    }
+
+    QString message;
+    int contextId{-1};
+
+    if (takePending(*t.buffer, message, contextId))
+    {
+        emitOutput(message, contextId);
+    }
+}
+
+void
+GtpyContextManager::startOutputTimer()
+{
+    auto* mgr = GtpyContextManager::instance();
+
+    if (!mgr || outputBuffers().timerActive.exchange(true))
+    {
+        return;
+    }
+
+    QPointer<QTimer> timer{mgr->m_outputTimer};
+
+    QMetaObject::invokeMethod(mgr, [timer](){
+        if (timer) timer->start();
+    }, Qt::QueuedConnection);
+}
+
+void
+GtpyContextManager::flushPendingOutput()
+{
+    auto& all = outputBuffers();
+
+    auto flushAll = [&all]() {
+        QList<std::shared_ptr<OutputBuffer>> buffers;
+
+        {
+            QMutexLocker locker{&all.mutex};
+            buffers = all.buffers;
+        }
+
+        bool remaining{false};
+
+        for (const auto& buffer : qAsConst(buffers))
+        {
+            QString message;
+            int contextId{-1};
+
+            if (takePending(*buffer, message, contextId,
+                            OUTPUT_FLUSH_INTERVAL))
+            {
+                emitOutput(message, contextId);
+                continue;
+            }
+
+            QMutexLocker locker{&buffer->mutex};
+            remaining |= !buffer->pending.isEmpty();
+        }
+
+        return remaining;
+    };
+
+    if (flushAll()) return;
+
+    {
+        // remove the flushed buffers of finished threads
+        QMutexLocker locker{&all.mutex};
+
+        all.buffers.erase(std::remove_if(
+            all.buffers.begin(), all.buffers.end(),
+            [](const std::shared_ptr<OutputBuffer>& buffer) {
+            if (buffer.use_count() > 1) return false;
+            QMutexLocker bufferLocker{&buffer->mutex};
+            return buffer->pending.isEmpty();
+        }), all.buffers.end());
+    }
+
+    m_outputTimer->stop();
+    all.timerActive = false;
 
-    //    else
-    //    {
-    //        std::cout << message.toLatin1().data() << std::endl;
-    //    }
+    // output written after the check above must not get stuck
+    if (flushAll() && !all.timerActive.exchange(true))
+    {
+        m_outputTimer->start();
+    }
 }
 
 int
 GtpyContextManager::contextIdByName(const QString& contextName)
 {
-    GTPY_GIL_SCOPE
+    QReadLocker locker{&m_contextLock};
 
-    QList<int> ids = m_contextMap.keys();
-
-    foreach (int id, ids)
+    for (auto it = m_contextMap.constBegin(); it != m_contextMap.constEnd();
+         ++it)
     {
-        auto con = context(id);
-        assert(con);
+        assert(it.value());
 
-        if (con->moduleName() == contextName)
+        if (it.value()->moduleName() == contextName)
         {
-            return id;
+            return it.key();
         }
     }
 
@@ -1925,6 +2409,8 @@ GtpyContextManager::onErrorMessage(const QString& message)
 {
     GTPY_GIL_SCOPE
 
+    flushStdOut();
+
     const auto threadDict = PyPPThreadState_GetDict();
 
     if (!threadDict)
@@ -1981,6 +2467,13 @@ GtpyContextManager::deleteRunnable()
 void
 GtpyContextManager::collectionChanged(const QString& collectionPath)
 {
+    // the watcher also observes the directories of sys.path
+    if (m_moduleScanner.paths().contains(collectionPath))
+    {
+        m_moduleScanner.rescan(collectionPath);
+        return;
+    }
+
     QDir dir(collectionPath);
     dir.setFilter(QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks);
 
@@ -2007,6 +2500,9 @@ GtpyContextManager::onProjectChanged(GtProject* project) const
         gtpy::utils::removeFromSysPath(gtpy::utils::projectPyScriptsPath(proj));
     }
 
+    gtpy::codecache::setPersistentCacheDir(
+        gtpy::utils::projectPyCachePath(project));
+
     if (!project) return;
 
     gtpy::utils::addToSysPath(gtpy::utils::projectPyScriptsPath(project));
@@ -13,8 +13,14 @@
 
 #include "gt_pythonmodule_exports.h"
 
+#include <climits>
+#include <functional>
+#include <memory>
+
 #include <QObject>
 #include <QMutex>
+#include <QSet>
+#include <QReadWriteLock>
 #include <QFileSystemWatcher>
 
 #include "PythonQtObjectPtr.h"
@@ -22,9 +28,12 @@
 #include "gt_version.h"
 
 #include "gtpy_context.h"
+#include "gtpy_contextpool.h"
 #include "gtpy_gilscope.h"
+#include "gtpy_modulescanner.h"
 #include "gtpypp.h"
 
+class QTimer;
 class GtObject;
 class GtTask;
 class GtpyDecorator;
@@ -133,6 +142,27 @@ public:
                     const bool output = true, const bool errorMessage = true,
                     const GtpyContextManager::EvalOptions& option = EvalFile);
 
+    /**
+    * @brief Evaluates the given script into the given python context in a
+    * thread of the global thread pool. The returned runnable is the handle
+    * of the evaluation: interrupt() cancels it. The caller owns the runnable
+    * and may delete it in the callback, or pass it to autoDeleteRunnable()
+    * to cancel the evaluation without waiting for it.
+    * @param contextId Python context identifier.
+    * @param script The script to be executed.
+    * @param receiver The callback is invoked in the thread of the receiver.
+    * It is not invoked if the receiver is destroyed before.
+    * @param finished Callback invoked with the result of the evaluation.
+    * @param output Emit output messages.
+    * @param option Evaluation options.
+    * @return The runnable that evaluates the script.
+    */
+    GtpyScriptRunnable* evalScriptAsync(
+            int contextId, const QString& script, QObject* receiver,
+            std::function<void(bool success)> finished,
+            const bool output = true,
+            const GtpyContextManager::EvalOptions& option = EvalFile);
+
     /**
     * @brief introspection
     * @param contextId
@@ -279,7 +309,9 @@ public:
     QString loggingPrefix(int contextId) const;
 
     /**
-    * @brief Initializes a Python context for each value of the enum Context.
+    * @brief Initializes the Python extensions and registers a Python context
+    * for each value of the enum Context. The contexts are created on first
+    * access by context().
     */
     void initContexts();
 
@@ -294,13 +326,43 @@ public:
                          bool emitSignal = false);
 
     /**
-    * @brief Deletes the python context with the given id.
+    * @brief Deletes the python context with the given id. If the context pool
+    * of the context's type is not full, the context is reset and returned to
+    * the pool instead of being destroyed.
     * @param contextId Id of a python context.
     * @param emitSignal If true, contextDeleted(contextId) will be emitted.
     * @return True, if the deletion was successful.
     */
     bool deleteContext(int contextId, bool emitSignal = false);
 
+    /**
+    * @brief Sets the number of pre-initialized contexts of the given type
+    * that are kept ready for createNewContext(). The pool is refilled in the
+    * background. By default, the pool size is 2 for TaskRunContext and
+    * CalculatorRunContext and 0 for all other types.
+    * @param type Context type.
+    * @param size Number of pre-initialized contexts. Zero disables pooling.
+    */
+    void setContextPoolSize(const GtpyContextManager::Context& type, int size);
+
+    /**
+    * @brief Returns the number of pre-initialized contexts of the given type
+    * that are kept ready for createNewContext().
+    * @param type Context type.
+    * @return Pool size of the given type.
+    */
+    int contextPoolSize(const GtpyContextManager::Context& type) const;
+
+    /**
+    * @brief Returns the statistics of the context pool for the given type,
+    * i.e. the number of idle contexts and the number of hits and misses of
+    * createNewContext().
+    * @param type Context type.
+    * @return Statistics of the context pool.
+    */
+    GtpyContextPool::Statistics contextPoolStatistics(
+            const GtpyContextManager::Context& type) const;
+
     /**
     * @brief Resets the Python context indicated by contextId to and
     * initializes it with the functionality of type.
@@ -364,19 +426,25 @@ public:
     void addModulePath(const QString& path);
 
     /**
-     * Initializes the Matplotlib backend
-     * Returns false, if matplotlib is not installed or cannot be imported
+     * Registers the Matplotlib backend. Matplotlib is not imported, the
+     * backend is selected when user code imports matplotlib for the first
+     * time.
+     * Returns false, if the import hook cannot be installed
      */
     bool initMatplotlib();
 
-    GtpyContext const * context(int contextId) const;
+    std::shared_ptr<const GtpyContext> context(int contextId) const;
 
     /**
-    * @brief Returns a pointer to the Python context indicated by contextId.
+    * @brief Returns the Python context indicated by contextId. A system
+    * context is created on the first call. The returned pointer shares the
+    * ownership of the context, so the context stays alive while it is used,
+    * even if deleteContext() is called concurrently. Callers must hold it for
+    * the whole evaluation or introspection instead of keeping a raw pointer.
     * @param contextId Python context identifier.
-    * @return Pointer to Python Context, nullptr if contextid is invalid
+    * @return Python Context, nullptr if contextid is invalid
     */
-    GtpyContext* context(int contextId);
+    std::shared_ptr<GtpyContext> context(int contextId);
 
 protected:
     /**
@@ -486,12 +554,19 @@ private:
     * @brief Used to obtain the built-in functions of python
     * @return builtin fucntions of python
     */
-    QMultiMap<QString, GtpyFunction> builtInCompletions(int contextId) const;
+    QMultiMap<QString, GtpyFunction> builtInCompletions() const;
+
+    /**
+    * @brief Sets the completions of the importable modules found by the
+    * module scanner to the member variable.
+    */
+    void setImportableModulesCompletions();
 
     /**
-    * @brief Obtains importable modules and sets it to member variable
+    * @brief Passes the directories of sys.path to the module scanner and
+    * watches them for changes.
     */
-    void setImportableModulesCompletions(int contextId);
+    void updateModulePaths();
 
     /**
     * @brief Returns the constractor functions for the calculators.
@@ -502,10 +577,10 @@ private:
 
     /**
     * @brief Sets custom completions and builtin completions to member
-    *  variable. Removes duplicates in these
-    * @param contextId Python context identifier.
+    *  variable. Removes duplicates in these. It is called once by
+    *  initContexts().
     */
-    void setStandardCompletions(int contextId);
+    void setStandardCompletions();
 
     /**
     * @brief Registers the type converters in PythonQt that implemented in
@@ -521,27 +596,44 @@ private:
 
     /**
     * @brief Callback for stdout redirection.
-    * It emits the pythonMessage() signal to share the message.
-    * @param contextName Name of the context in which the message was
-    * triggered.
-    * @param output Determines whether the output should be displayed or not.
-    * @param error Determines whether the error should be displayed or not.
+    * The message is appended to the pending output of the calling thread,
+    * which is emitted by the pythonMessage() signal in batches. The batch is
+    * flushed if it contains a line break and the last flush of the thread
+    * is at least 50 ms ago, if it exceeds 4096 characters, at the end of
+    * evalScript() and on sys.stdout.flush(). Output that is not flushed by
+    * the thread itself is flushed by a timer of the context manager after
+    * 50 ms. Messages of the batch context are printed directly.
     * @param message Message to emit.
     */
-    static void stdOutRedirectCB(const QString& contextName, const bool output,
-                                 const bool error, const QString& message);
+    static void stdOutRedirectCB(const QString& message);
 
     /**
     * @brief Callback for stderr redirection.
-    * It emits the errorMessage() and the errorCodeLine() signal to share the
-    * error message.
-    * @param contextName Name of the context in which the error occurred.
-    * @param output Determines whether the output should be displayed or not.
-    * @param error Determines whether the error should be displayed or not.
+    * It flushes the pending output of the calling thread and emits the
+    * errorMessage() and the errorCodeLine() signal to share the error
+    * message.
     * @param message Error message to emit.
     */
-    static void stdErrRedirectCB(const QString& contextName, const bool output,
-                                 const bool error, const QString& message);
+    static void stdErrRedirectCB(const QString& message);
+
+    /**
+    * @brief Emits the pending output of the calling thread by the
+    * pythonMessage() signal.
+    */
+    static void flushStdOut();
+
+    /**
+    * @brief Starts the output timer in the thread of the context manager,
+    * unless it is already running.
+    */
+    static void startOutputTimer();
+
+    /**
+    * @brief Emits the pending output of all threads whose last flush is at
+    * least 50 ms ago. Called by the output timer, which is stopped once no
+    * output is pending.
+    */
+    void flushPendingOutput();
 
     /**
     * @brief Returns the id of the context with the given name.
@@ -557,9 +649,31 @@ private:
     */
     QString contextNameById(int contextId);
 
+    /**
+    * @brief Returns whether the context with the given id has access to
+    * the calculators.
+    * @param contextId Id of the context.
+    * @return True if the context has access to the calculators.
+    */
+    bool isCalcAccessible(int contextId) const;
+
+    /**
+    * @brief Creates the system context with the given id, unless another
+    * thread created it in the meantime.
+    * @param contextId Id of the system context.
+    * @return The system context with the given id.
+    */
+    std::shared_ptr<GtpyContext> createSystemContext(int contextId);
+
     /// Map of Python context
     QMap<int, std::shared_ptr<GtpyContext>> m_contextMap;
 
+    /// System contexts that are created on first access
+    QSet<int> m_pendingContexts;
+
+    /// Pre-initialized contexts for createNewContext()
+    GtpyContextPool m_contextPool;
+
     /// Whether the contexts send messages to the application console
     QMap<int, bool> m_appLogging;
 
@@ -569,12 +683,20 @@ private:
     /// Output emitter
     PythonQtObjectPtr m_out;
 
-    /// Standard completions for pytho completer
+    /// Standard completions for pytho completer. Set once by
+    /// initContexts() and only read afterwards.
     QMultiMap<QString, GtpyFunction> m_standardCompletions;
 
     /// Contains completions of importable modules
     QMultiMap<QString, GtpyFunction> m_importableModulesCompletions;
 
+    /// Guards m_importableModulesCompletions, which is updated by the module
+    /// scanner while completers introspect in their own thread
+    mutable QMutex m_completionsMutex;
+
+    /// Names of the modules compiled into the interpreter
+    QStringList m_builtinModules;
+
     /// Decorator instance
     GtpyDecorator* m_decorator;
 
@@ -593,9 +715,18 @@ private:
     /// Calculator accessible contexts
     QList<int> m_calcAccessibleContexts;
 
+    /// Guards m_contextMap, m_addedObjectNames and m_calcAccessibleContexts,
+    /// since contexts are created and deleted by tasks running in parallel.
+    /// Never lock the GIL while holding this lock.
+    mutable QReadWriteLock m_contextLock;
+
     /// Python main thread state
     PyThreadState* m_pyThreadState;
 
+    /// Flushes the output of threads that stopped writing, see
+    /// stdOutRedirectCB()
+    QTimer* m_outputTimer;
+
     /// True if this module initialized/owns the Python interpreter lifecycle
     bool m_ownsPythonInterpreter;
 
@@ -603,9 +734,12 @@ private:
 
     QMutex m_evalMutex;
 
-    /// File system watcher
+    /// File system watcher for the script collection and sys.path
     QFileSystemWatcher m_watcher;
 
+    /// Background scan of the modules importable from sys.path
+    GtpyModuleScanner m_moduleScanner;
+
 private slots:
     /**
     * @brief Emits errorMessage signal.
@@ -627,7 +761,8 @@ private slots:
 
     /**
      * @brief Adds new collection paths to the sys.path list after updating the
-     * script collection.
+     * script collection. Changes of directories in sys.path trigger a new
+     * scan for importable modules.
      * @param collectionPath Path to script collection.
      */
     void collectionChanged(const QString& collectionPath);
@@ -769,6 +904,92 @@ public:
                                            int /*metaTypeId*/, bool /*strict*/);
 
 private:
+    /**
+    * @brief Converts the given key or value directly into a new Python
+    * object without boxing it into a QVariant.
+    * @param val Value to convert.
+    * @return New reference to the Python object.
+    */
+    static PyObject* toPython(int val)
+    {
+        return PyLong_FromLong(val);
+    }
+
+    static PyObject* toPython(double val)
+    {
+        return PyFloat_FromDouble(val);
+    }
+
+    static PyObject* toPython(const QString& val)
+    {
+        return PythonQtConv::QStringToPyObject(val);
+    }
+
+    /**
+    * @brief Converts the given Python object of the exactly matching Python
+    * type directly into the output value. Objects of other types are
+    * converted through QVariant as before.
+    * @param obj Python object to convert.
+    * @param out Output value.
+    * @return False if the object cannot be represented by the output type,
+    * e.g. an integer out of the range of int.
+    */
+    static bool fromPython(PyObject* obj, int& out)
+    {
+        if (PyLong_Check(obj))
+        {
+            int overflow = 0;
+            long long val = PyLong_AsLongLongAndOverflow(obj, &overflow);
+
+            if (overflow != 0 || val < INT_MIN || val > INT_MAX)
+            {
+                return false;
+            }
+
+            if (!PyErr_Occurred())
+            {
+                out = static_cast<int>(val);
+                return true;
+            }
+
+            PyErr_Clear();
+        }
+
+        out = PyPPObject_AsQVariant(PyPPObject::Borrow(obj)).value<int>();
+        return true;
+    }
+
+    static bool fromPython(PyObject* obj, double& out)
+    {
+        if (PyFloat_Check(obj))
+        {
+            out = PyFloat_AS_DOUBLE(obj);
+            return true;
+        }
+
+        out = PyPPObject_AsQVariant(PyPPObject::Borrow(obj)).value<double>();
+        return true;
+    }
+
+    static bool fromPython(PyObject* obj, QString& out)
+    {
+        if (PyUnicode_Check(obj))
+        {
+            Py_ssize_t size = 0;
+
+            if (const char* utf8 = PyUnicode_AsUTF8AndSize(obj, &size))
+            {
+                out = QString::fromUtf8(utf8, static_cast<int>(size));
+                return true;
+            }
+
+            PyErr_Clear();
+        }
+
+        out = PyPPObject_AsQVariant(PyPPObject::Borrow(obj)).value<QString>();
+        return true;
+    }
+
     /**
     * @brief Template function for converting QMap instances into Python
     * objects independent of the key/value type.
@@ -780,23 +1001,21 @@ private:
     {
         GTPY_GIL_SCOPE
 
-        QMap<Key, Val>& map = *((QMap<Key, Val>*) inMap);
+        const QMap<Key, Val>& map = *static_cast<const QMap<Key, Val>*>(inMap);
 
         auto result = PyPPDict_New();
+        if (!result) return nullptr;
 
-        //QMap<Key, Val>::const_iterator    t;
-        //t = map.constBegin();
-        QList<Key> keys = map.keys();
-
-        //for ( ; t != map.constEnd(); t++)
-        foreach (Key k, keys)
+        for (auto iter = map.constBegin(); iter != map.constEnd(); ++iter)
         {
-            // converts key and value to QVariant and then to PyObject*
-            auto key = PyPPObject::fromQVariant(QVariant(k));
-            auto val = PyPPObject::fromQVariant(QVariant(map.value(k)));
-
-            // sets key and val to the result dict
-            PyPPDict_SetItem(result, key, val);
+            auto key = PyPPObject::NewRef(toPython(iter.key()));
+            auto val = PyPPObject::NewRef(toPython(iter.value()));
+
+            if (!key.get() || !val.get() ||
+                PyPPDict_SetItem(result, key, val) != 0)
+            {
+                return nullptr;
+            }
         }
 
         return result.release();
@@ -804,7 +1023,8 @@ private:
 
     /**
     * @brief Template function for converting Python objects into QMap
-    * instances independent of the key/value type.
+    * instances independent of the key/value type. Dicts are iterated in
+    * place, other mappings through their items.
     * @param obj Python object to convert.
     * @param outMap QMap output.
     * @return Whether the conversion was successful or not.
@@ -814,31 +1034,50 @@ private:
     {
         GTPY_GIL_SCOPE
 
-        auto obj = PyPPObject::Borrow(objIn);
+        QMap<Key, Val>& map = *static_cast<QMap<Key, Val>*>(outMap);
 
+        Key key{};
+        Val val{};
 
-        if (!PyPPMapping_Check(obj)) return false;
+        if (PyDict_Check(objIn))
+        {
+            PyObject* pyKey = nullptr;
+            PyObject* pyValue = nullptr;
+            Py_ssize_t pos = 0;
+
+            while (PyDict_Next(objIn, &pos, &pyKey, &pyValue))
+            {
+                if (!fromPython(pyKey, key) || !fromPython(pyValue, val))
+                {
+                    return false;
+                }
 
-        QString tempFunc = "items";
-        QByteArray ba = tempFunc.toLocal8Bit();
-        char* func = ba.data();
+                map.insert(key, val);
+            }
+
+            return true;
+        }
+
+        auto obj = PyPPObject::Borrow(objIn);
+
+        if (!PyPPMapping_Check(obj)) return false;
 
-        auto items = PyPPObject_CallMethod(obj, func, NULL);
+        auto items = PyPPObject::NewRef(PyMapping_Items(objIn));
         if (!items) return false;
 
-        QMap<Key, Val>& map = *((QMap<Key, Val>*) outMap);
         int count = PyPPList_Size(items);
 
         for (int i = 0; i < count; i++)
         {
             auto pyTuple = PyPPList_GetItem(items, i);
-            auto pyKey = PyPPTuple_GetItem(pyTuple, 0);
-            auto pyValue = PyPPTuple_GetItem(pyTuple, 1);
 
-            QVariant key = PyPPObject_AsQVariant(pyKey);
-            QVariant val = PyPPObject_AsQVariant(pyValue);
+            if (!fromPython(PyPPTuple_GetItem(pyTuple, 0).get(), key) ||
+                !fromPython(PyPPTuple_GetItem(pyTuple, 1).get(), val))
+            {
+                return false;
+            }
 
-            map.insert(key.value<Key>(), val.value<Val>());
+            map.insert(key, val);
         }
 
         return true;
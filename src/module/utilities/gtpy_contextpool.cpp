@@ -0,0 +1,241 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: gtpy_contextpool.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <QRunnable>
+#include <QMutexLocker>
+
+#include "gtpy_contextpool.h"
+
+namespace {
+
+/**
+ * @brief Runnable that fills the pool for one context type.
+ */
+class GtpyContextPoolRefill : public QRunnable
+{
+public:
+    GtpyContextPoolRefill(GtpyContextPool& pool,
+                          GtpyContext::ContextType type) :
+        m_pool(pool), m_type(type)
+    {
+        setAutoDelete(true);
+    }
+
+    void run() override
+    {
+        m_pool.fill(m_type);
+    }
+
+private:
+    GtpyContextPool& m_pool;
+    GtpyContext::ContextType m_type;
+};
+
+}
+
+GtpyContextPool::GtpyContextPool()
+{
+    m_refillThreads.setMaxThreadCount(1);
+}
+
+std::shared_ptr<GtpyContext>
+GtpyContextPool::acquire(GtpyContext::ContextType type)
+{
+    std::shared_ptr<GtpyContext> context;
+
+    {
+        QMutexLocker locker{&m_mutex};
+
+        auto& entry = m_entries[type];
+
+        if (entry.capacity > 0)
+        {
+            if (!entry.contexts.isEmpty())
+            {
+                context = entry.contexts.takeLast();
+                ++entry.hits;
+            }
+            else
+            {
+                ++entry.misses;
+            }
+
+            scheduleRefill(type);
+        }
+    }
+
+    if (!context) context = std::make_shared<GtpyContext>(type);
+
+    return context;
+}
+
+void
+GtpyContextPool::release(std::shared_ptr<GtpyContext> context)
+{
+    // Contexts that are still referenced elsewhere cannot be reused
+    if (!context || context.use_count() > 1) return;
+
+    const auto type = context->type();
+
+    {
+        QMutexLocker locker{&m_mutex};
+
+        auto entry = m_entries.constFind(type);
+
+        if (entry == m_entries.constEnd() ||
+            entry->contexts.size() >= entry->capacity) return;
+    }
+
+    if (!context->reset()) return;
+
+    QMutexLocker locker{&m_mutex};
+
+    auto& entry = m_entries[type];
+
+    if (entry.contexts.size() >= entry.capacity) return;
+
+    entry.contexts.append(std::move(context));
+}
+
+void
+GtpyContextPool::setCapacity(GtpyContext::ContextType type, int capacity)
+{
+    // discarded contexts must be destroyed after unlocking the mutex
+    QList<std::shared_ptr<GtpyContext>> discarded;
+
+    QMutexLocker locker{&m_mutex};
+
+    auto& entry = m_entries[type];
+    entry.capacity = std::max(0, capacity);
+
+    while (entry.contexts.size() > entry.capacity)
+    {
+        discarded.append(entry.contexts.takeLast());
+    }
+
+    scheduleRefill(type);
+}
+
+int
+GtpyContextPool::capacity(GtpyContext::ContextType type) const
+{
+    QMutexLocker locker{&m_mutex};
+
+    auto entry = m_entries.constFind(type);
+
+    return entry != m_entries.constEnd() ? entry->capacity : 0;
+}
+
+GtpyContextPool::Statistics
+GtpyContextPool::statistics(GtpyContext::ContextType type) const
+{
+    QMutexLocker locker{&m_mutex};
+
+    Statistics stats;
+
+    auto entry = m_entries.constFind(type);
+    if (entry == m_entries.constEnd()) return stats;
+
+    stats.size = entry->contexts.size();
+    stats.capacity = entry->capacity;
+    stats.hits = entry->hits;
+    stats.misses = entry->misses;
+
+    return stats;
+}
+
+void
+GtpyContextPool::setRefillEnabled(bool enable)
+{
+    QMutexLocker locker{&m_mutex};
+
+    m_refillEnabled = enable;
+
+    if (!m_refillEnabled) return;
+
+    const auto types = m_entries.keys();
+
+    for (int type : types)
+    {
+        scheduleRefill(static_cast<GtpyContext::ContextType>(type));
+    }
+}
+
+void
+GtpyContextPool::fill(GtpyContext::ContextType type)
+{
+    forever
+    {
+        {
+            QMutexLocker locker{&m_mutex};
+
+            auto& entry = m_entries[type];
+
+            if (entry.contexts.size() >= entry.capacity)
+            {
+                entry.refillPending = false;
+                return;
+            }
+        }
+
+        auto context = std::make_shared<GtpyContext>(type);
+
+        // the locker is destroyed before the context, so a surplus context
+        // is destroyed after unlocking the mutex
+        QMutexLocker locker{&m_mutex};
+
+        auto& entry = m_entries[type];
+
+        if (entry.contexts.size() >= entry.capacity)
+        {
+            entry.refillPending = false;
+            return;
+        }
+
+        entry.contexts.append(std::move(context));
+    }
+}
+
+void
+GtpyContextPool::clear()
+{
+    // discarded contexts must be destroyed after unlocking the mutex
+    QList<std::shared_ptr<GtpyContext>> discarded;
+
+    QMutexLocker locker{&m_mutex};
+
+    for (auto& entry : m_entries)
+    {
+        discarded.append(entry.contexts);
+        entry.contexts.clear();
+    }
+}
+
+void
+GtpyContextPool::shutdown()
+{
+    setRefillEnabled(false);
+
+    m_refillThreads.waitForDone();
+
+    clear();
+}
+
+void
+GtpyContextPool::scheduleRefill(GtpyContext::ContextType type)
+{
+    auto& entry = m_entries[type];
+
+    if (!m_refillEnabled || entry.refillPending ||
+        entry.contexts.size() >= entry.capacity) return;
+
+    entry.refillPending = true;
+
+    m_refillThreads.start(new GtpyContextPoolRefill(*this, type));
+}
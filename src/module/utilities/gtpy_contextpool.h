@@ -0,0 +1,169 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: gtpy_contextpool.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#ifndef GTPY_CONTEXTPOOL_H
+#define GTPY_CONTEXTPOOL_H
+
+#include <memory>
+
+#include <QMap>
+#include <QList>
+#include <QMutex>
+#include <QThreadPool>
+
+#include "gt_pythonmodule_exports.h"
+
+#include "gtpy_context.h"
+
+/**
+ * @brief The GtpyContextPool class holds pre-initialized GtpyContext
+ * instances for each GtpyContext::ContextType. Creating a context imports
+ * several modules and evaluates the predefined Python code, which is
+ * expensive compared to short scripts that are executed many times (e.g.
+ * Python tasks in an optimization loop). The pool hands out contexts that
+ * are ready to use and takes them back after resetting them to their initial
+ * state. Contexts taken out of the pool are refilled by a background
+ * runnable.
+ *
+ * A capacity of zero disables pooling for the given ContextType. In this
+ * case, acquire() creates a new context and release() destroys it.
+ */
+class GT_PYTHON_EXPORT GtpyContextPool
+{
+public:
+    /**
+     * @brief The Statistics struct summarizes the state of the pool for
+     * one ContextType.
+     */
+    struct Statistics
+    {
+        /// Number of idle contexts currently stored in the pool
+        int size = 0;
+
+        /// Maximum number of idle contexts stored in the pool
+        int capacity = 0;
+
+        /// Number of acquire() calls served by a pooled context
+        quint64 hits = 0;
+
+        /// Number of acquire() calls that had to create a new context
+        quint64 misses = 0;
+    };
+
+    GtpyContextPool();
+
+    GtpyContextPool(const GtpyContextPool&) = delete;
+    GtpyContextPool& operator=(const GtpyContextPool&) = delete;
+
+    /**
+     * @brief Returns a context of the given type. If the pool holds an idle
+     * context of this type, it is returned. Otherwise, a new context is
+     * created. In both cases, a refill of the pool is triggered.
+     * @param type Type of the requested context.
+     * @return A context of the given type.
+     */
+    std::shared_ptr<GtpyContext> acquire(GtpyContext::ContextType type);
+
+    /**
+     * @brief Returns the given context to the pool. The context is reset to
+     * its initial state before it is stored. If the pool for the type of the
+     * context is full or the context is still referenced elsewhere, the
+     * context is discarded.
+     * @param context Context to return.
+     */
+    void release(std::shared_ptr<GtpyContext> context);
+
+    /**
+     * @brief Sets the maximum number of idle contexts stored for the given
+     * type. Surplus contexts are discarded. If refilling is enabled, the pool
+     * is refilled in the background.
+     * @param type Context type.
+     * @param capacity Maximum number of idle contexts. Zero disables pooling.
+     */
+    void setCapacity(GtpyContext::ContextType type, int capacity);
+
+    /**
+     * @brief Returns the maximum number of idle contexts stored for the
+     * given type.
+     * @param type Context type.
+     * @return Maximum number of idle contexts.
+     */
+    int capacity(GtpyContext::ContextType type) const;
+
+    /**
+     * @brief Returns the current statistics of the pool for the given type.
+     * @param type Context type.
+     * @return Statistics of the pool.
+     */
+    Statistics statistics(GtpyContext::ContextType type) const;
+
+    /**
+     * @brief Enables or disables the background refill. The refill is
+     * disabled by default and should be enabled once the Python extensions
+     * required by the contexts are initialized. Note that the pool must
+     * outlive the background refill once it is enabled.
+     * @param enable True if the pool should be refilled in the background.
+     */
+    void setRefillEnabled(bool enable);
+
+    /**
+     * @brief Creates contexts of the given type until the pool is full.
+     * It is called by the background refill, but may also be called
+     * directly to warm up the pool synchronously.
+     * @param type Context type.
+     */
+    void fill(GtpyContext::ContextType type);
+
+    /**
+     * @brief Discards all idle contexts. Capacities and statistics are kept.
+     */
+    void clear();
+
+    /**
+     * @brief Disables the background refill, waits for running refills to
+     * finish and discards all idle contexts. It must be called before the
+     * Python interpreter is finalized and without holding the GIL, since the
+     * refill needs it to create contexts.
+     */
+    void shutdown();
+
+private:
+    struct Entry
+    {
+        QList<std::shared_ptr<GtpyContext>> contexts;
+        int capacity = 0;
+        quint64 hits = 0;
+        quint64 misses = 0;
+        bool refillPending = false;
+    };
+
+    /**
+     * @brief Starts a background runnable to refill the pool for the given
+     * type, if necessary. Expects m_mutex to be locked.
+     * @param type Context type.
+     */
+    void scheduleRefill(GtpyContext::ContextType type);
+
+    /// Pool entries by context type
+    QMap<int, Entry> m_entries;
+
+    /// Whether the pool is refilled in the background
+    bool m_refillEnabled{false};
+
+    /// Guards m_entries and m_refillEnabled. Contexts are never created or
+    /// destroyed while holding this mutex, since both require the GIL.
+    mutable QMutex m_mutex;
+
+    /// Dedicated thread for the background refill. Refills must not block
+    /// the global thread pool, which runs tasks and scripts. Declared last,
+    /// so it waits for running refills before the other members are gone.
+    QThreadPool m_refillThreads;
+};
+
+#endif // GTPY_CONTEXTPOOL_H
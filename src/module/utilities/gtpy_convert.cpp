@@ -10,6 +10,8 @@
 
 #include "gtpy_convert.h"
 
+#include <cstring>
+
 #include "PythonQtConversion.h"
 
 #if GT_VERSION >= GT_VERSION_CHECK(2, 0, 0)
@@ -53,3 +55,110 @@ gtpy::convert::fromPropertyStructContainer(const GtPropertyStructContainer& con)
 }
 
 #endif
+
+namespace
+{
+
+bool
+isNativeDoubleFormat(const char* format)
+{
+    if (!format) return false;
+
+    // '@' and '=' denote the native byte order
+    if (*format == '@' || *format == '=') ++format;
+
+    return std::strcmp(format, "d") == 0;
+}
+
+bool
+fromBuffer(PyObject* obj, QVector<double>& values)
+{
+    Py_buffer view;
+
+    if (PyObject_GetBuffer(obj, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0)
+    {
+        PyErr_Clear();
+        return false;
+    }
+
+    bool ok = view.itemsize == sizeof(double) &&
+              isNativeDoubleFormat(view.format);
+
+    if (ok)
+    {
+        values.resize(static_cast<int>(view.len / view.itemsize));
+        std::memcpy(values.data(), view.buf,
+                    static_cast<size_t>(values.size()) * sizeof(double));
+    }
+
+    PyBuffer_Release(&view);
+
+    return ok;
+}
+
+bool
+fromSequence(PyObject* obj, QVector<double>& values)
+{
+    auto seq = PyPPObject::NewRef(PySequence_Fast(obj, ""));
+
+    if (!seq)
+    {
+        PyErr_Clear();
+        return false;
+    }
+
+    auto size = PySequence_Fast_GET_SIZE(seq.get());
+    PyObject** items = PySequence_Fast_ITEMS(seq.get());
+
+    QVector<double> result(static_cast<int>(size));
+
+    for (Py_ssize_t i = 0; i < size; ++i)
+    {
+        result[static_cast<int>(i)] = PyFloat_AsDouble(items[i]);
+
+        if (PyErr_Occurred())
+        {
+            PyErr_Clear();
+            return false;
+        }
+    }
+
+    values = std::move(result);
+
+    return true;
+}
+
+} // namespace
+
+PyPPObject
+gtpy::convert::toDoubleBuffer(const QVector<double>& values)
+{
+    GTPY_GIL_SCOPE
+
+    auto bytes = PyPPObject::NewRef(PyByteArray_FromStringAndSize(
+        reinterpret_cast<const char*>(values.constData()),
+        static_cast<Py_ssize_t>(values.size()) * sizeof(double)));
+
+    if (!bytes) return {};
+
+    auto view = PyPPObject::NewRef(PyMemoryView_FromObject(bytes.get()));
+
+    if (!view) return {};
+
+    return PyPPObject_CallMethod(view, "cast", "s", "d");
+}
+
+bool
+gtpy::convert::fromDoubleBuffer(PyObject* obj, QVector<double>& values)
+{
+    if (!obj) return false;
+
+    GTPY_GIL_SCOPE
+
+    if (PyObject_CheckBuffer(obj) && fromBuffer(obj, values)) return true;
+
+    // bytes-like objects of other formats are no sequences of numbers
+    if (PyBytes_Check(obj) || PyByteArray_Check(obj)) return false;
+
+    return fromSequence(obj, values);
+}
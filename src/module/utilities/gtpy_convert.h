@@ -16,6 +16,8 @@
 #include <Python.h>
 #include "gtpypp.h"
 
+#include <QVector>
+
 #if GT_VERSION >= GT_VERSION_CHECK(2, 0, 0)
 #include "gt_propertystructcontainer.h"
 #endif
@@ -40,6 +42,30 @@ PyPPObject
 fromPropertyStructContainer(const GtPropertyStructContainer& con);
 #endif
 
+/**
+ * @brief Copies the passed values into one contiguous buffer and returns a
+ * writable Python memoryview of format 'd' on it. No Python object is
+ * created per value, and numpy.asarray() wraps the memoryview without
+ * copying it again. The memoryview is independent of the source of the
+ * values.
+ * @param values Values to export.
+ * @return Memoryview on the values or a null object on failure.
+ */
+PyPPObject toDoubleBuffer(const QVector<double>& values);
+
+/**
+ * @brief Reads the values of the passed Python object into the passed
+ * vector. Objects supporting the buffer protocol with C-contiguous data of
+ * native double format (e.g. float64 NumPy arrays or memoryviews returned
+ * by toDoubleBuffer()) are copied at once. Other sequences are read value
+ * by value.
+ * @param obj Python object to read.
+ * @param values Vector to write the values to.
+ * @return True if all values could be read. Otherwise, values is left
+ * unchanged.
+ */
+bool fromDoubleBuffer(PyObject* obj, QVector<double>& values);
+
 } // namespace convert
 
 } // namespace gtpy
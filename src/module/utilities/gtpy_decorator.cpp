@@ -8,9 +8,14 @@
  * Author: Marvin Noethen (DLR AT-TWK)
  */
 
+#include <QSet>
 #include <QDebug>
 #include <QMetaMethod>
 #include <QStringList>
+#include <QSignalBlocker>
+#include <QMutex>
+
+#include <functional>
 
 #include "PythonQtPythonInclude.h"
 
@@ -38,6 +43,8 @@
 #include "gtpy_convert.h"
 #include "gtpy_threadscope.h"
 #include "gtpy_taskapi.h"
+#include "gtpy_childindex.h"
+#include "gtpy_batchrunner.h"
 
 #include "gtpy_decorator.h"
 
@@ -46,6 +53,66 @@ using namespace GtpyExtendedWrapperModule;
 namespace
 {
 
+/**
+ * Serializes calls of the application and data model API, which is not
+ * thread-safe, e.g. if batch scripts are evaluated concurrently. The GIL is
+ * released while the lock is held, so that a thread waiting for the lock
+ * does not block the Python code of the others. Code guarded by the lock
+ * must not run Python code that uses the API again.
+ */
+class AppApiLock
+{
+public:
+    AppApiLock()
+    {
+        if (PyGILState_Check()) m_state = PyEval_SaveThread();
+
+        mutex().lock();
+    }
+
+    ~AppApiLock()
+    {
+        mutex().unlock();
+
+        if (m_state) PyEval_RestoreThread(m_state);
+    }
+
+    AppApiLock(const AppApiLock&) = delete;
+    AppApiLock& operator=(const AppApiLock&) = delete;
+
+private:
+    PyThreadState* m_state{nullptr};
+
+    static QMutex&
+    mutex()
+    {
+        static QMutex m;
+        return m;
+    }
+};
+
+/**
+ * @brief Returns whether the application and project API may be used by the
+ * calling script. Scripts of parallel batch jobs run in pool threads, which
+ * must not touch the application or a project, so an error is sent to them
+ * instead.
+ * @param decorator Decorator sending the error message.
+ * @return True if the API may be used.
+ */
+bool
+appApiAvailable(GtpyDecorator& decorator)
+{
+    if (!gtpy::batch::isParallelJob()) return true;
+
+    QString output = QStringLiteral("ERROR: ") +
+                     QObject::tr("the application and project API is not "
+                                 "available in parallel batch jobs!");
+
+    qWarning() << output;
+    emit decorator.sendErrorMessage(output);
+    return false;
+}
+
 GtProject*
 openProjectFromID(GtpyDecorator& decorator, GtCoreApplication* app,
                   const QString& projectId)
@@ -169,6 +236,20 @@ GtpyDecorator::wrapGtObject(GtObject* obj, Ownership owner)
         return {};
     }
 
+    // objects owned by C++ keep their wrapper while it is alive, so
+    // navigating to them again does not allocate and preserves identity
+    if (owner == CPP)
+    {
+        if (PyObject* cached = GtpyExtendedWrapperModule::cachedWrapper(obj))
+        {
+            return PyPPObject::NewRef(cached);
+        }
+    }
+    else
+    {
+        GtpyExtendedWrapperModule::removeCachedWrapper(obj);
+    }
+
     auto pyQtWrapper = PyPPObject::fromQObject(obj);
 
     if (pyQtWrapper && pyQtWrapper->ob_type->tp_base !=
@@ -186,6 +267,16 @@ GtpyDecorator::wrapGtObject(GtObject* obj, Ownership owner)
 
     GtpyExtendedWrapper* self = (GtpyExtendedWrapper*)(retval.get());
 
+    if (!self)
+    {
+        return {};
+    }
+
+    if (owner == CPP)
+    {
+        GtpyExtendedWrapperModule::setCachedWrapper(self);
+    }
+
     if (owner == Python || owner == ForcePython)
     {
         if (self->_obj) self->_obj->passOwnershipToPython();
@@ -217,6 +308,8 @@ GtpyDecorator::wrapGtObject(std::unique_ptr<GtObject>&& obj)
 void
 GtpyDecorator::init(GtCoreApplication* app, const QString& id)
 {
+    if (!appApiAvailable(*this)) return;
+
     if (app == nullptr)
     {
         QString output = QStringLiteral("ERROR: ") +
@@ -230,7 +323,11 @@ GtpyDecorator::init(GtCoreApplication* app, const QString& id)
     }
 
     qDebug() << "Decorator:     app->init()";
-    app->init();
+
+    {
+        AppApiLock lock;
+        app->init();
+    }
 
     initLanguage(app);
     initDatamodel(app);
@@ -242,6 +339,8 @@ GtpyDecorator::init(GtCoreApplication* app, const QString& id)
 void
 GtpyDecorator::initLanguage(GtCoreApplication* app)
 {
+    if (!appApiAvailable(*this)) return;
+
     if (app == nullptr)
     {
         QString output = QStringLiteral("ERROR: ") +
@@ -255,12 +354,15 @@ GtpyDecorator::initLanguage(GtCoreApplication* app)
     }
 
     qDebug() << "Decorator:     app->initLanguage()";
+    AppApiLock lock;
     app->initLanguage();
 }
 
 void
 GtpyDecorator::initDatamodel(GtCoreApplication* app)
 {
+    if (!appApiAvailable(*this)) return;
+
     if (app == nullptr)
     {
         QString output = QStringLiteral("ERROR: ") +
@@ -274,12 +376,15 @@ GtpyDecorator::initDatamodel(GtCoreApplication* app)
     }
 
     qDebug() << "Decorator:     app->initDatamodel()";
+    AppApiLock lock;
     app->initDatamodel();
 }
 
 void
 GtpyDecorator::loadModules(GtCoreApplication* app)
 {
+    if (!appApiAvailable(*this)) return;
+
     if (app == nullptr)
     {
         QString output = QStringLiteral("ERROR: ") +
@@ -293,12 +398,15 @@ GtpyDecorator::loadModules(GtCoreApplication* app)
     }
 
     qDebug() << "Decorator:     app->loadModules()";
+    AppApiLock lock;
     app->loadModules();
 }
 
 void
 GtpyDecorator::initCalculators(GtCoreApplication* app)
 {
+    if (!appApiAvailable(*this)) return;
+
     if (app == nullptr)
     {
         QString output = QStringLiteral("ERROR: ") +
@@ -312,12 +420,15 @@ GtpyDecorator::initCalculators(GtCoreApplication* app)
     }
 
     qDebug() << "Decorator:     app->initCalculators()";
+    AppApiLock lock;
     app->initCalculators();
 }
 
 void
 GtpyDecorator::initSession(GtCoreApplication* app, const QString& id)
 {
+    if (!appApiAvailable(*this)) return;
+
     if (app == nullptr)
     {
         QString output = QStringLiteral("ERROR: ") +
@@ -331,12 +442,15 @@ GtpyDecorator::initSession(GtCoreApplication* app, const QString& id)
     }
 
     qDebug() << "Decorator:     app->initSession(id) : id == " << id;
+    AppApiLock lock;
     app->initSession(id);
 }
 
 void
 GtpyDecorator::switchSession(GtCoreApplication* app, const QString& id)
 {
+    if (!appApiAvailable(*this)) return;
+
     if (app == nullptr)
     {
         QString output = QStringLiteral("ERROR: ") +
@@ -350,12 +464,15 @@ GtpyDecorator::switchSession(GtCoreApplication* app, const QString& id)
     }
 
     qDebug() << "Decorator:     app->switchSession(id) : id == " << id;
+    AppApiLock lock;
     app->switchSession(id);
 }
 
 PyObjectAPIReturn GtpyDecorator::openProject(GtCoreApplication* app,
                                      const QString& projectIdOrPath)
 {
+    if (!appApiAvailable(*this)) return nullptr;
+
     if (!app)
     {
         QString output = QStringLiteral("ERROR: ") +
@@ -367,19 +484,26 @@ PyObjectAPIReturn GtpyDecorator::openProject(GtCoreApplication* app,
 
 
     GtProject* project = nullptr;
+    bool opened = false;
 
-    if (QFile(projectIdOrPath).exists())
     {
-        project = openProjectFromPath(*this, app, projectIdOrPath);
-    }
-    else
-    {
-        project = openProjectFromID(*this, app, projectIdOrPath);
+        AppApiLock lock;
+
+        if (QFile(projectIdOrPath).exists())
+        {
+            project = openProjectFromPath(*this, app, projectIdOrPath);
+        }
+        else
+        {
+            project = openProjectFromID(*this, app, projectIdOrPath);
+        }
+
+        opened = project && gtDataModel->GtCoreDatamodel::openProject(project);
     }
 
     if (!project) return nullptr;
 
-    if (!gtDataModel->GtCoreDatamodel::openProject(project))
+    if (!opened)
     {
         QString output = QStringLiteral("ERROR: ") +
                          QObject::tr("could not open project '%1'")
@@ -399,6 +523,8 @@ PyObjectAPIReturn GtpyDecorator::openProject(GtCoreApplication* app,
 PyObjectAPIReturn
 GtpyDecorator::currentProject(GtCoreApplication* app)
 {
+    if (!appApiAvailable(*this)) return nullptr;
+
     if (app == nullptr)
     {
         QString output = QStringLiteral("ERROR: ") +
@@ -411,7 +537,14 @@ GtpyDecorator::currentProject(GtCoreApplication* app)
         return nullptr;
     }
 
-    return wrapGtObject(app->currentProject()).release();
+    GtProject* project = nullptr;
+
+    {
+        AppApiLock lock;
+        project = app->currentProject();
+    }
+
+    return wrapGtObject(project).release();
 }
 
 const QString
@@ -472,6 +605,8 @@ bool
 GtpyDecorator::runProcess(GtProject* pro, const QString& processId,
                           bool save)
 {
+    if (!appApiAvailable(*this)) return false;
+
     if (pro == nullptr)
     {
         QString output =  QStringLiteral("ERROR: ") +
@@ -542,7 +677,14 @@ GtpyDecorator::runProcess(GtProject* pro, const QString& processId,
 
     if (save)
     {
-        if (!gtDataModel->saveProject(pro))
+        bool saved = false;
+
+        {
+            AppApiLock lock;
+            saved = gtDataModel->saveProject(pro);
+        }
+
+        if (!saved)
         {
             QString output = QStringLiteral("ERROR: ") +
                              QObject::tr("project could not besaved!") +
@@ -714,6 +856,8 @@ GtpyDecorator::run(GtTask* task)
 bool
 GtpyDecorator::close(GtProject* pro, bool save)
 {
+    if (!appApiAvailable(*this)) return false;
+
     if (pro == nullptr)
     {
         QString output =  QStringLiteral("ERROR: ") +
@@ -728,7 +872,14 @@ GtpyDecorator::close(GtProject* pro, bool save)
 
     if (save)
     {
-        if (!gtDataModel->saveProject(pro))
+        bool saved = false;
+
+        {
+            AppApiLock lock;
+            saved = gtDataModel->saveProject(pro);
+        }
+
+        if (!saved)
         {
             QString output = QStringLiteral("ERROR: ") +
                              QObject::tr("project could not besaved!") +
@@ -743,7 +894,14 @@ GtpyDecorator::close(GtProject* pro, bool save)
         }
     }
 
-    if (!gtDataModel->closeProject(pro))
+    bool closed = false;
+
+    {
+        AppApiLock lock;
+        closed = gtDataModel->closeProject(pro);
+    }
+
+    if (!closed)
     {
         QString output = QStringLiteral("ERROR: ") +
                          QObject::tr("could not close project!") +
@@ -901,7 +1059,7 @@ GtpyDecorator::findGtChild(GtObject* obj, const QString& childName)
         return nullptr;
     }
 
-    GtObject* child = obj->findDirectChild<GtObject*>(childName);
+    auto* child = gtpy::childindex::findChild<GtObject*>(obj, childName);
     return wrapGtObject(child).release();
 }
 
@@ -922,7 +1080,8 @@ GtpyDecorator::findGtChildren(GtObject* obj, const QString& childrenName,
     }
     else
     {
-        children = obj->findDirectChildren<GtObject*>(childrenName);
+        children = gtpy::childindex::findChildren<GtObject*>(
+                    obj, childrenName);
     }
 
 
@@ -1146,6 +1305,116 @@ GtpyDecorator::setPropertyContainerVal(GtObject* obj, const QString& id,
     return false;
 }
 
+PyObjectAPIReturn
+GtpyDecorator::getPropertyContainerColumn(GtObject* obj, const QString& id,
+                                          const QString& memberId)
+{
+    GtPropertyStructContainer* s = structContainerOfObject(obj, id);
+
+    if (!s)
+    {
+        gtError() << __func__ << " -> PropertyStruct container of "
+                                 "object not found!";
+        return nullptr;
+    }
+
+    QVector<double> values;
+    values.reserve(s->size());
+
+    for (const auto& entry : *s)
+    {
+        bool ok{false};
+        double val = entry.getMemberValToVariant(memberId, &ok).toDouble(&ok);
+
+        if (!ok)
+        {
+            gtError() << __func__ << tr("-> Parameter %1 of entry %2 in "
+                                        "container %3 is not numeric")
+                         .arg(memberId, entry.ident(), id);
+            return nullptr;
+        }
+
+        values.append(val);
+    }
+
+    return gtpy::convert::toDoubleBuffer(values).release();
+}
+
+bool
+GtpyDecorator::setPropertyContainerColumn(GtObject* obj, const QString& id,
+                                          const QString& memberId,
+                                          PyObject* values)
+{
+    GtPropertyStructContainer* s = structContainerOfObject(obj, id);
+
+    if (!s)
+    {
+        gtError() << __func__ << " -> PropertyStruct container of "
+                                 "object not found!";
+        return false;
+    }
+
+    QVector<double> vals;
+
+    if (!gtpy::convert::fromDoubleBuffer(values, vals))
+    {
+        gtError() << __func__ << " -> Values must be a sequence of numbers!";
+        return false;
+    }
+
+    if (vals.size() != s->size())
+    {
+        gtError() << __func__ << tr("-> Expected %1 values for container %2, "
+                                    "got %3").arg(s->size()).arg(id)
+                     .arg(vals.size());
+        return false;
+    }
+
+    // check all entries before changing any of them
+    QVector<QVariant> oldVals;
+    oldVals.reserve(s->size());
+
+    for (const auto& entry : *s)
+    {
+        bool ok{false};
+        auto val = entry.getMemberValToVariant(memberId, &ok);
+
+        if (ok) val.toDouble(&ok);
+
+        if (!ok)
+        {
+            gtError() << __func__ << tr("-> Parameter %1 of entry %2 in "
+                                        "container %3 is not numeric")
+                         .arg(memberId, entry.ident(), id);
+            return false;
+        }
+
+        oldVals.append(val);
+    }
+
+    int i = 0;
+    for (auto& entry : *s)
+    {
+        if (entry.setMemberVal(memberId, vals.at(i)))
+        {
+            ++i;
+            continue;
+        }
+
+        // revert the entries changed so far
+        int j = 0;
+        for (auto& changed : *s)
+        {
+            if (j == i) break;
+            changed.setMemberVal(memberId, oldVals.at(j++));
+        }
+
+        return false;
+    }
+
+    return true;
+}
+
 #endif
 QList<GtAbstractProperty*>
 GtpyDecorator::findGtProperties(GtObject* obj)
@@ -1212,6 +1481,33 @@ GtpyDecorator::setPropertyValue(GtObject* obj, const QString& id,
         return;
     }
 
+    if (!resolveObjectLink(prop, val))
+    {
+        return;
+    }
+
+    //    GtCommand cmmd = gtApp->startCommand(
+    //                gtApp->currentProject(), prop->objectName() +
+    //                         QStringLiteral(" of ") + obj->objectName() +
+    //                         QStringLiteral(" changed!"));
+
+    bool success = prop->setValueFromVariant(val, QString());
+
+    //    gtApp->endCommand(cmmd);
+
+    if (!success)
+    {
+        QString output = QStringLiteral("ERROR: ") +
+                         QObject::tr("Invalid input type for ") +
+                         prop->objectName() + QObject::tr("!");
+
+        emit sendErrorMessage(output);
+    }
+}
+
+bool
+GtpyDecorator::resolveObjectLink(GtAbstractProperty* prop, QVariant& val)
+{
     if (auto* objLinkProp = qobject_cast<GtObjectLinkProperty*>(prop))
     {
         auto* dataObj = qvariant_cast<GtObject*>(val);
@@ -1273,28 +1569,192 @@ GtpyDecorator::setPropertyValue(GtObject* obj, const QString& id,
 
                 emit sendErrorMessage(output);
 
-                return;
+                return false;
             }
         }
     }
 
-    //    GtCommand cmmd = gtApp->startCommand(
-    //                gtApp->currentProject(), prop->objectName() +
-    //                         QStringLiteral(" of ") + obj->objectName() +
-    //                         QStringLiteral(" changed!"));
+    return true;
+}
 
-    bool success = prop->setValueFromVariant(val, QString());
+QVariantMap
+GtpyDecorator::getProperties(GtObject* obj, const QStringList& ids)
+{
+    if (!obj) return {};
 
-    //    gtApp->endCommand(cmmd);
+    QSet<QString> remaining;
+    for (const auto& id : ids) remaining.insert(id);
 
-    if (!success)
+    QVariantMap retval;
+
+    const auto propList = obj->fullPropertyList();
+
+    for (auto* prop : propList)
     {
-        QString output = QStringLiteral("ERROR: ") +
-                         QObject::tr("Invalid input type for ") +
-                         prop->objectName() + QObject::tr("!");
+        if (!ids.isEmpty() && !remaining.remove(prop->ident())) continue;
 
-        emit sendErrorMessage(output);
+        retval.insert(prop->ident(), prop->valueToVariant());
+    }
+
+    if (!remaining.isEmpty())
+    {
+        QStringList missing = remaining.values();
+        missing.sort();
+
+        QString message = "\n\n" + QString(obj->metaObject()->className()) +
+                          " has no GtProperty with the id(s): " +
+                          missing.join(", ");
+
+        throw std::runtime_error(message.toStdString());
+    }
+
+    return retval;
+}
+
+void
+GtpyDecorator::setProperties(GtObject* obj, const QVariantMap& values)
+{
+    if (!obj || values.isEmpty()) return;
+
+    // collect all properties first, so that either all or no property is set
+    QList<QPair<GtAbstractProperty*, QVariant>> changes;
+    changes.reserve(values.size());
+
+    QSet<QString> found;
+
+    const auto propList = obj->fullPropertyList();
+
+    for (auto* prop : propList)
+    {
+        auto iter = values.constFind(prop->ident());
+
+        // the first property with the id wins, like in findProperty()
+        if (iter == values.constEnd() || found.contains(iter.key())) continue;
+
+        found.insert(iter.key());
+        changes.append({prop, iter.value()});
+    }
+
+    if (changes.size() != values.size())
+    {
+        QStringList missing;
+
+        for (auto iter = values.constBegin(); iter != values.constEnd(); ++iter)
+        {
+            if (!found.contains(iter.key())) missing.append(iter.key());
+        }
+
+        QString message = "\n\n" + QString(obj->metaObject()->className()) +
+                          " has no GtProperty with the id(s): " +
+                          missing.join(", ");
+
+        throw std::runtime_error(message.toStdString());
+    }
+
+    // resolve and convert all values before any property is changed
+    QStringList invalid;
+
+    for (auto& change : changes)
+    {
+        auto* prop = change.first;
+        auto& val = change.second;
+
+        if (!resolveObjectLink(prop, val))
+        {
+            invalid.append(prop->ident());
+            continue;
+        }
+
+        const auto current = prop->valueToVariant();
+
+        if (current.isValid() && !val.convert(current.userType()))
+        {
+            invalid.append(prop->ident());
+        }
+    }
+
+    if (!invalid.isEmpty())
+    {
+        QString message = "\n\nInvalid input type for the GtProperty "
+                          "id(s): " + invalid.join(", ");
+
+        throw std::runtime_error(message.toStdString());
+    }
+
+    // observers must not see a partially applied batch, so the notifications
+    // of the object and its properties are deferred until all values are set
+    QList<QPair<GtAbstractProperty*, QVariant>> applied;
+
+    {
+        QSignalBlocker blocker(obj);
+
+        for (auto& change : changes)
+        {
+            auto* prop = change.first;
+
+            const QSignalBlocker propBlocker(prop);
+
+            const auto oldValue = prop->valueToVariant();
+
+            if (prop->setValueFromVariant(change.second, QString()))
+            {
+                applied.append({prop, oldValue});
+                continue;
+            }
+
+            // the property rejected a converted value (e.g. a bounded one),
+            // so the changes applied so far are reverted
+            for (const auto& undo : qAsConst(applied))
+            {
+                const QSignalBlocker undoBlocker(undo.first);
+                undo.first->setValueFromVariant(undo.second, QString());
+            }
+
+            QString message = "\n\nInvalid value for the GtProperty id: " +
+                              prop->ident();
+
+            throw std::runtime_error(message.toStdString());
+        }
     }
+
+    for (const auto& change : qAsConst(applied))
+    {
+        emit obj->dataChanged(obj, change.first);
+    }
+
+    emit obj->dataChanged(obj);
+}
+
+QVariantMap
+GtpyDecorator::snapshotProperties(GtObject* root)
+{
+    if (!root) return {};
+
+    QVariantMap retval;
+
+    std::function<void(GtObject*, const QString&)> snapshot =
+            [&](GtObject* obj, const QString& path) {
+        // objects with equal names would overwrite each other's values
+        if (retval.contains(path))
+        {
+            QString message = "\n\nThe object path '" + path + "' is not "
+                              "unique. Rename the objects to take a snapshot.";
+
+            throw std::runtime_error(message.toStdString());
+        }
+
+        retval.insert(path, getProperties(obj));
+
+        for (auto* child : obj->findDirectChildren<GtObject*>())
+        {
+            snapshot(child, path.isEmpty() ? child->objectName() :
+                                             path + "/" + child->objectName());
+        }
+    };
+
+    snapshot(root, QString());
+
+    return retval;
 }
 
 QString
@@ -1631,6 +2091,88 @@ GtpyDecorator::entries(GtDataZone0D* dataZone, bool* ok)
     return retVal;
 }
 
+PyObjectAPIReturn
+GtpyDecorator::entriesArray(GtDataZone0D* dataZone)
+{
+    if (!dataZone)
+    {
+        return nullptr;
+    }
+
+#if GT_VERSION >= GT_VERSION_CHECK(2, 0, 0)
+    auto data = dataZone->fetchData();
+#else
+    auto& data = *dataZone;
+#endif
+
+    const QStringList params = data.params();
+
+    QVector<double> values;
+    values.reserve(params.size());
+
+    for (const QString& p : params)
+    {
+        values.append(data.value(p));
+    }
+
+    return gtpy::convert::toDoubleBuffer(values).release();
+}
+
+bool
+GtpyDecorator::setEntriesArray(GtDataZone0D* dataZone, PyObject* values)
+{
+    if (!dataZone)
+    {
+        return false;
+    }
+
+    QVector<double> vals;
+
+    if (!gtpy::convert::fromDoubleBuffer(values, vals))
+    {
+        gtError() << __func__ << " -> Values must be a sequence of numbers!";
+        return false;
+    }
+
+#if GT_VERSION >= GT_VERSION_CHECK(2, 0, 0)
+    auto data = dataZone->fetchData();
+#else
+    auto& data = *dataZone;
+#endif
+
+    const QStringList params = data.params();
+
+    if (vals.size() != params.size())
+    {
+        gtError() << __func__ << tr("-> Expected %1 values, got %2")
+                     .arg(params.size()).arg(vals.size());
+        return false;
+    }
+
+    QVector<double> oldVals;
+    oldVals.reserve(params.size());
+
+    for (const QString& p : params)
+    {
+        oldVals.append(data.value(p));
+    }
+
+    for (int i = 0; i < params.size(); ++i)
+    {
+        if (data.setValue(params.at(i), vals.at(i))) continue;
+
+        // revert the values changed so far
+        for (int j = 0; j < i; ++j)
+        {
+            data.setValue(params.at(j), oldVals.at(j));
+        }
+
+        return false;
+    }
+
+    return true;
+}
+
 bool
 GtpyDecorator::setValue(GtDataZone0D* dataZone, const QString& paramName,
                         const double& value)
@@ -485,6 +485,39 @@ public slots:
     bool setPropertyContainerVal(GtObject* obj, QString const& id,
                                  const QString& entryId,
                                  QString const& memberId, const QVariant& val);
+
+    /**
+     * @brief Returns the numeric values of the member memberId of all entries
+     * of a struct container as a memoryview of format 'd'. The values are
+     * copied into one contiguous buffer, which can be wrapped by
+     * numpy.asarray() without further copies.
+     * @param obj - parent object of the struct propety
+     * @param id of the property struct container
+     * @param memberId of the property to read
+     * @return memoryview on the values - None for invalid inputs or
+     * non-numeric values
+     * Example call in python:
+     *  etas = numpy.asarray(task.getPropertyContainerColumn("points", "eta"))
+     */
+    PyObjectAPIReturn getPropertyContainerColumn(GtObject* obj,
+                                                 const QString& id,
+                                                 const QString& memberId);
+
+    /**
+     * @brief Sets the member memberId of all entries of a struct container
+     * to the given values. Objects supporting the buffer protocol with
+     * float64 data (e.g. NumPy arrays) are read at once. All entries are
+     * checked before any of them is changed, so the container is either
+     * updated completely or not at all.
+     * @param obj - parent object of the struct propety
+     * @param id of the property struct container
+     * @param memberId of the property to set
+     * @param values - one value per container entry
+     * @return true in case of success, else false
+     */
+    bool setPropertyContainerColumn(GtObject* obj, const QString& id,
+                                    const QString& memberId,
+                                    PyObject* values);
 #endif
     /**
      * @brief findGtProperties returns all properties of a GtObject
@@ -521,6 +554,46 @@ public slots:
     SET_PROPERTY_VALUE void setPropertyValue(GtObject* obj, const QString& id,
             QVariant val);
 
+    /**
+     * @brief Returns the values of several properties in a single pass over
+     * the property list of the object.
+     * Example:
+     *  values = calc.getProperties(["eta", "pi"])
+     * @param obj Pointer to GtObject.
+     * @param ids Ids of the properties. If empty, the values of all
+     * properties are returned.
+     * @return Dict mapping the property ids to their values.
+     */
+    QVariantMap getProperties(GtObject* obj, const QStringList& ids = {});
+
+    /**
+     * @brief Sets the values of several properties in a single pass over
+     * the property list of the object. All values are validated and
+     * converted before any property is changed. If one of the ids does not
+     * exist or one of the values is invalid, no property is changed. The
+     * change notifications of the object are emitted after the whole batch
+     * is applied: one per changed property and one for the object.
+     * Example:
+     *  calc.setProperties({"eta": 0.9, "pi": 1.5})
+     * @param obj Pointer to GtObject.
+     * @param values Dict mapping the property ids to their new values.
+     */
+    void setProperties(GtObject* obj, const QVariantMap& values);
+
+    /**
+     * @brief Returns the property values of the given object and all its
+     * descendants. The keys of the returned dict are the object paths
+     * relative to root, separated by '/' (the root itself is the empty
+     * string). The values are dicts as returned by getProperties().
+     * An error is raised if two objects have the same path, e.g. siblings
+     * with equal names.
+     * Example:
+     *  snapshot = pkg.snapshotProperties()
+     * @param root Pointer to GtObject.
+     * @return Property values by relative object path.
+     */
+    QVariantMap snapshotProperties(GtObject* root);
+
     /**
      * @brief Decorator function to uuid function of GtObject.
      * @param obj Pointer to GtObject.
@@ -677,6 +750,24 @@ public slots:
      */
     QMap<QString, double> entries(GtDataZone0D* dataZone, bool* ok = nullptr);
 
+    /**
+     * @brief Returns the values of the datazone in the order of its params
+     * as a memoryview of format 'd', which can be wrapped by numpy.asarray()
+     * without copies.
+     * @param dataZone - data to export
+     * @return memoryview on the values - None for invalid inputs
+     */
+    PyObjectAPIReturn entriesArray(GtDataZone0D* dataZone);
+
+    /**
+     * @brief Sets the values of the datazone in the order of its params.
+     * If a value cannot be set, the values set before are reverted.
+     * @param dataZone - data to modify
+     * @param values - one value per param, e.g. a NumPy float64 array
+     * @return true in case of success, else false
+     */
+    bool setEntriesArray(GtDataZone0D* dataZone, PyObject* values);
+
     bool setValue(GtDataZone0D* dataZone, const QString& paramName,
                   const double& value);
 
@@ -688,6 +779,17 @@ public slots:
 #endif
 
 
+private:
+    /**
+     * @brief If prop is an object link property and val holds a GtObject,
+     * val is replaced by the UUID of the object. An error message is emitted
+     * if the class of the object is not allowed for the property.
+     * @param prop Property to be set.
+     * @param val Value to be set.
+     * @return False if the object is not allowed for the property.
+     */
+    bool resolveObjectLink(GtAbstractProperty* prop, QVariant& val);
+
 signals:
     /**
      * @brief sendPythonConsoleOutput signal for transmitting an output message
@@ -8,42 +8,142 @@
  * Author: Marvin Noethen (DLR AT-TWK)
  */
 
+#include <chrono>
+
+#include <QMutex>
+
 #include "gtpy_gilscope.h"
 
-bool GtpyGilScope::m_enableGILScope = false;
+namespace
+{
+
+std::atomic<bool> s_enableGILScope{false};
+
+std::atomic<bool> s_instrumentation{false};
+
+struct Sites
+{
+    QList<GtpyGilScope::Site*> sites;
+
+    QMutex mutex;
+};
+
+// Intentionally leaked, since GIL scopes may be used during shutdown
+Sites&
+sites()
+{
+    static auto* s = new Sites;
+    return *s;
+}
+
+void
+record(GtpyGilScope::Site& site, std::chrono::steady_clock::duration wait)
+{
+    using namespace std::chrono;
+
+    site.count.fetch_add(1, std::memory_order_relaxed);
+    site.waitTime.fetch_add(duration_cast<nanoseconds>(wait).count(),
+                            std::memory_order_relaxed);
+
+    if (site.registered.exchange(true)) return;
 
-GtpyGilScope::GtpyGilScope() : m_ensured(false)
+    auto& s = sites();
+
+    QMutexLocker locker(&s.mutex);
+    s.sites.append(&site);
+}
+
+} // namespace
+
+GtpyGilScope::GtpyGilScope(Site& site)
 {
-    if (m_enableGILScope)
+    if (!s_enableGILScope.load(std::memory_order_relaxed)) return;
+
+    // the thread holds the GIL in nested scopes and in functions called from
+    // Python, unless an enclosing scope released it temporarily
+    if (PyGILState_Check()) return;
+
+    if (!s_instrumentation.load(std::memory_order_relaxed))
     {
         m_state = PyGILState_Ensure();
         m_ensured = true;
+        return;
     }
-}
 
-GtpyGilScope::~GtpyGilScope()
-{
-    release();
+    auto start = std::chrono::steady_clock::now();
+
+    m_state = PyGILState_Ensure();
+    m_ensured = true;
+
+    record(site, std::chrono::steady_clock::now() - start);
 }
 
-void
-GtpyGilScope::release()
+GtpyGilScope::~GtpyGilScope()
 {
     if (m_ensured)
     {
         PyGILState_Release(m_state);
-        m_ensured = false;
     }
 }
 
 void
 GtpyGilScope::setGILScopeEnabled(bool flag)
 {
-    m_enableGILScope = flag;
+    s_enableGILScope = flag;
 }
 
 bool
 GtpyGilScope::isGILScopeEnabled()
 {
-    return m_enableGILScope;
+    return s_enableGILScope;
+}
+
+void
+GtpyGilScope::setInstrumentationEnabled(bool enable)
+{
+    s_instrumentation = enable;
+}
+
+bool
+GtpyGilScope::isInstrumentationEnabled()
+{
+    return s_instrumentation;
+}
+
+QList<GtpyGilScope::Statistics>
+GtpyGilScope::statistics()
+{
+    auto& s = sites();
+
+    QMutexLocker locker(&s.mutex);
+
+    QList<Statistics> retval;
+    retval.reserve(s.sites.size());
+
+    for (const auto* site : qAsConst(s.sites))
+    {
+        Statistics stats;
+        stats.file = QString::fromUtf8(site->file);
+        stats.line = site->line;
+        stats.count = site->count.load(std::memory_order_relaxed);
+        stats.waitTime = site->waitTime.load(std::memory_order_relaxed);
+
+        retval.append(stats);
+    }
+
+    return retval;
+}
+
+void
+GtpyGilScope::resetStatistics()
+{
+    auto& s = sites();
+
+    QMutexLocker locker(&s.mutex);
+
+    for (auto* site : qAsConst(s.sites))
+    {
+        site->count = 0;
+        site->waitTime = 0;
+    }
 }
@@ -14,28 +14,83 @@
 #include "PythonQtPythonInclude.h"
 #include "gt_pythonmodule_exports.h"
 
-#include <QObject>
+#include <atomic>
 
-#define GTPY_GIL_SCOPE GtpyGilScope internal_gilscope;
+#include <QList>
+#include <QString>
 
 /**
- * @brief The GtpyGilScope class
+ * Acquires the GIL for the current block. Each use has its own call site
+ * record, which collects the GIL wait times if the instrumentation is enabled.
  */
-class GT_PYTHON_EXPORT GtpyGilScope : public QObject
-{
-    Q_OBJECT
+#define GTPY_GIL_SCOPE \
+    static GtpyGilScope::Site internal_gilsite{__FILE__, __LINE__}; \
+    GtpyGilScope internal_gilscope{internal_gilsite};
 
+/**
+ * @brief The GtpyGilScope class ensures that the current thread holds the GIL
+ * while the scope exists. It lives on the stack only. If the thread holds the
+ * GIL already, e.g. in nested scopes or in functions called from Python, the
+ * scope does nothing.
+ */
+class GT_PYTHON_EXPORT GtpyGilScope
+{
 public:
     /**
-     * @brief The GtpyGilScope constructor.
+     * @brief Call site of a GIL scope. The values are only updated if the
+     * instrumentation is enabled.
+     */
+    struct Site
+    {
+        /// Source file of the call site
+        const char* file;
+
+        /// Line of the call site
+        int line;
+
+        /// Number of scopes that acquired the GIL
+        std::atomic<qint64> count{0};
+
+        /// Total time waited for the GIL in nanoseconds
+        std::atomic<qint64> waitTime{0};
+
+        /// Site is listed in the statistics
+        std::atomic<bool> registered{false};
+    };
+
+    /**
+     * @brief GIL wait time statistics of one call site.
+     */
+    struct Statistics
+    {
+        /// Source file of the call site
+        QString file;
+
+        /// Line of the call site
+        int line{0};
+
+        /// Number of scopes that acquired the GIL
+        qint64 count{0};
+
+        /// Total time waited for the GIL in nanoseconds
+        qint64 waitTime{0};
+    };
+
+    /**
+     * @brief The GtpyGilScope constructor acquires the GIL if the GIL scope is
+     * enabled and the current thread does not hold it yet.
+     * @param site Call site of the scope.
      */
-    GtpyGilScope();
+    explicit GtpyGilScope(Site& site);
 
     /**
-     * @brief Destructor releases the GIL.
+     * @brief Destructor releases the GIL if it was acquired by this scope.
      */
     ~GtpyGilScope();
 
+    GtpyGilScope(const GtpyGilScope&) = delete;
+    GtpyGilScope& operator=(const GtpyGilScope&) = delete;
+
     /**
      * @brief Sets m_enableGILScope to the specified flag.
      * @param flage True if the GIL scope should be enabled.
@@ -48,21 +103,37 @@ public:
      */
     static bool isGILScopeEnabled();
 
-private slots:
     /**
-     * @brief Releases the GIL.
+     * @brief Enables or disables recording the GIL wait time per call site.
+     * It is disabled by default.
+     * @param enable True if the wait times should be recorded.
+     */
+    static void setInstrumentationEnabled(bool enable);
+
+    /**
+     * @brief Returns whether the GIL wait times are recorded.
+     * @return Whether the GIL wait times are recorded.
      */
-    void release();
+    static bool isInstrumentationEnabled();
+
+    /**
+     * @brief Returns the recorded GIL wait times of all call sites that
+     * acquired the GIL while the instrumentation was enabled.
+     * @return Statistics per call site.
+     */
+    static QList<Statistics> statistics();
+
+    /**
+     * @brief Resets the recorded GIL wait times.
+     */
+    static void resetStatistics();
 
 private:
     /// GIL state
     PyGILState_STATE m_state;
 
     /// GIL ensured
-    bool m_ensured;
-
-    /// GIL scope is enabled
-    static bool m_enableGILScope;
+    bool m_ensured{false};
 };
 
 #endif // GTPY_THREADSUPPORT_H
@@ -26,6 +26,7 @@ constexpr const char* COLLECTION_ID = "Python Script Collection";
 constexpr const char* COLLECTION_CAT = "category";
 constexpr const char* COLLECTION_SUBCAT = "subcategory";
 constexpr const char* PROJ_PY_SCRIPTS_DIR = "scripts/python";
+constexpr const char* PROJ_PY_CACHE_DIR = "__pycache__";
 
 } // namespace constants
 
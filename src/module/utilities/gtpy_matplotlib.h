@@ -20,62 +20,289 @@ namespace matplotlib
 ///Backend name
 constexpr const char* backendName = "gtlab_svg_backend";
 
+///Name of the module that installs the backend on demand
+constexpr const char* hookName = "gtlab_matplotlib_hook";
+
+///Variable of the in-memory figure buffer in plot scripts
+constexpr const char* figureVariable = "__gtpy_figure__";
+
+/**
+ * Source of the backend module. It is executed when pyplot loads the backend
+ * for the first time.
+ */
 constexpr const char* customBackend = R"(
 import os
+import tempfile
 import threading
-import matplotlib.pyplot as plt
 from matplotlib.backend_bases import Gcf
 from matplotlib.backends.backend_svg import FigureCanvasSVG, FigureManagerSVG
+from matplotlib.figure import Figure
+
+import gtlab_matplotlib_hook as hook
 
 FigureCanvas = FigureCanvasSVG
 FigureManager = FigureManagerSVG
 
-global gt_temp
+gt_temp = os.path.join(tempfile.gettempdir(), "pid_{}".format(os.getpid()))
 
 backend_lock = threading.Lock()
 
+# data of figures with more points is rasterized for GTlab plots
+RASTER_THRESHOLD = 50000
+RASTER_DPI = 200
+
+_savefig = Figure.savefig
+_figure_init = Figure.__init__
+
+
+def _rasterize_large_data(fig, kwargs):
+    artists = []
+    points = 0
+
+    for ax in fig.get_axes():
+        for line in ax.lines:
+            points += len(line.get_xydata())
+            artists.append(line)
+
+        for collection in ax.collections:
+            points += max(len(collection.get_offsets()),
+                          len(collection.get_paths()))
+            artists.append(collection)
+
+    if points < RASTER_THRESHOLD:
+        return
+
+    # axes, ticks and text stay vector graphics
+    for artist in artists:
+        artist.set_rasterized(True)
+
+    kwargs.setdefault("dpi", RASTER_DPI)
+
+
+def _savefig_to_buffer(self, fname, *args, **kwargs):
+    # figures saved to an in-memory buffer of GTlab default to its format
+    if isinstance(fname, hook.FigureBuffer):
+        # the figure saved to the capture buffer is rendered later by GTlab
+        if hook.capture_saved(self, fname, kwargs):
+            return None
+
+        kwargs.setdefault("format", fname.format)
+        _rasterize_large_data(self, kwargs)
+
+    return _savefig(self, fname, *args, **kwargs)
+
+
+Figure.savefig = _savefig_to_buffer
+
+
+def _init_with_thread(self, *args, **kwargs):
+    # figures are shown by the thread that created them
+    _figure_init(self, *args, **kwargs)
+    self._gtpy_thread = threading.get_ident()
+
+
+Figure.__init__ = _init_with_thread
+
+
+def _thread_fig_managers():
+    ident = threading.get_ident()
+
+    return [m for m in Gcf.get_all_fig_managers()
+            if getattr(m.canvas.figure, "_gtpy_thread", ident) == ident]
+
 
 def set_temp_dir(d):
     global gt_temp
     gt_temp = d
 
 
+def _prepare(fig_manager):
+    fig = fig_manager.canvas.figure
+    fig.set_size_inches(6, 4)
+    fig.tight_layout()
+
+    return fig
+
+
 def show(*args, **kwargs):
-    with backend_lock:
-        global gt_temp
+    import matplotlib.pyplot as plt
 
+    # the figures are passed on to GTlab if it captures them
+    if hook.is_capturing():
+        for fig_manager in _thread_fig_managers():
+            fig = _prepare(fig_manager)
+
+            hook.capture(fig)
+            plt.close(fig)
+
+        return
+
+    with backend_lock:
         thread_path = os.path.join(gt_temp, str(threading.current_thread().ident))
         if not os.path.exists(thread_path):
             os.makedirs(thread_path, exist_ok=True)
 
-        for num, fig_manager in enumerate(Gcf.get_all_fig_managers()):
+        for num, fig_manager in enumerate(_thread_fig_managers()):
             output_path = os.path.join(thread_path, "figure_{}.svg".format(num))
 
-            fig = fig_manager.canvas.figure
-            fig.set_size_inches(6, 4)
-            fig.tight_layout()
-
+            fig = _prepare(fig_manager)
             fig.savefig(output_path, format='svg')
             plt.close(fig)
 )";
 
-constexpr const char* setCustomBackend = R"(
-try:
-    import os
-    import matplotlib
-    import tempfile
+/**
+ * Import hook that selects the backend when matplotlib is imported for the
+ * first time and provides the backend module from its source. Nothing of
+ * matplotlib is imported before the user code does so.
+ *
+ * Between begin_capture() and end_capture(), the figures shown by the
+ * backend and the figure saved to the returned FigureBuffer are collected
+ * for the calling thread. They are not rendered before render() is called
+ * with the token returned by end_capture(), which may be done in another
+ * thread.
+ */
+constexpr const char* lazyBackendHook = R"(
+import io
+import itertools
+import sys
+import threading
+from importlib.machinery import ModuleSpec
+
+BACKEND_NAME = "gtlab_svg_backend"
+
+_capture = threading.local()
+
+# captured figures waiting to be rendered by token
+_pending = {}
+_pending_lock = threading.Lock()
+_tokens = itertools.count(1)
+
+
+class FigureBuffer(io.BytesIO):
+    format = "svg"
+
+
+def begin_capture():
+    _capture.figures = []
+    _capture.saved = None
+    _capture.buffer = FigureBuffer()
+
+    return _capture.buffer
+
+
+def is_capturing():
+    return getattr(_capture, "figures", None) is not None
+
+
+def capture(fig):
+    _capture.figures.append((fig, {}))
+
+
+def capture_saved(fig, buffer, kwargs):
+    if not is_capturing() or buffer is not _capture.buffer:
+        return False
+
+    _capture.saved = (fig, dict(kwargs))
+    return True
+
+
+def end_capture():
+    figures = getattr(_capture, "figures", None) or []
+    saved = getattr(_capture, "saved", None)
+
+    _capture.figures = None
+    _capture.saved = None
+    _capture.buffer = None
+
+    if saved is not None:
+        figures.insert(0, saved)
+
+    with _pending_lock:
+        token = next(_tokens)
+        _pending[token] = figures
+
+    return token
+
+
+def render(token):
+    with _pending_lock:
+        figures = _pending.pop(token, [])
+
+    retval = []
+
+    for fig, kwargs in figures:
+        buffer = FigureBuffer()
+        fig.savefig(buffer, **kwargs)
+        retval.append(buffer.getvalue())
+
+    return retval
+
+
+def _use_backend(matplotlib):
+    try:
+        matplotlib.use("module://" + BACKEND_NAME)
+    except Exception:
+        pass
+
+
+class GtlabBackendFinder:
+
+    def __init__(self, backend_source):
+        self._backend_source = backend_source
+        self._configured = False
+
+    def find_spec(self, fullname, path=None, target=None):
+        if fullname == BACKEND_NAME:
+            return ModuleSpec(fullname, self)
+
+        if fullname == "matplotlib" and not self._configured:
+            return self._matplotlib_spec(fullname, path, target)
+
+        return None
+
+    def create_module(self, spec):
+        return None
+
+    def exec_module(self, module):
+        code = compile(self._backend_source, "<{}>".format(BACKEND_NAME), "exec")
+        exec(code, module.__dict__)
+
+    def configure(self, matplotlib):
+        self._configured = True
+        _use_backend(matplotlib)
+
+    def _matplotlib_spec(self, fullname, path, target):
+        spec = None
+
+        for finder in sys.meta_path:
+            find_spec = getattr(finder, "find_spec", None)
+            if finder is self or find_spec is None:
+                continue
+
+            spec = find_spec(fullname, path, target)
+            if spec is not None:
+                break
+
+        exec_module = getattr(spec.loader, "exec_module", None) if spec else None
+        if exec_module is None:
+            return spec
+
+        def exec_and_configure(module):
+            exec_module(module)
+            self.configure(module)
+
+        spec.loader.exec_module = exec_and_configure
+
+        return spec
 
-    from gtlab_svg_backend import set_temp_dir
 
-    pid = os.getpid()
-    dir_name = os.path.join(tempfile.gettempdir(), "pid_{}".format(pid))
-    if not os.path.exists(dir_name):
-        os.makedirs(dir_name, exist_ok=True)
+def install(backend_source):
+    finder = GtlabBackendFinder(backend_source)
+    sys.meta_path.insert(0, finder)
 
-    set_temp_dir(dir_name)
-    matplotlib.use("module://gtlab_svg_backend")
-except ImportError:
-    pass
+    # matplotlib may be imported already if the interpreter is not owned by GTlab
+    if "matplotlib" in sys.modules:
+        finder.configure(sys.modules["matplotlib"])
 )";
 
 } // namespace constants
@@ -8,11 +8,9 @@
  * Author: Marvin Noethen (DLR AT-TWK)
  */
 
-#include <QMutex>
-#include <QMutexLocker>
-
 #include "gtpy_regexp.h"
 #include "gtpy_gilscope.h"
+#include "gtpy_codecache.h"
 
 #include "gt_logging.h"
 
@@ -24,7 +22,7 @@ struct GtpyModule::Impl
     QString loggingPrefix{}; // An arbitrary prefix used currently for logging,
                              // e.g. to distiguish different nodes or calculators
     PyPPObject module{};
-    static QMutex evalMutex;
+    bool codeCacheEnabled{false}; // Whether eval() uses gtpy::codecache
 
     ~Impl()
     {
@@ -61,8 +59,6 @@ struct GtpyModule::Impl
     }
 };
 
-QMutex GtpyModule::Impl::evalMutex{};
-
 GtpyModule::GtpyModule(const QString& moduleName) :
     pimpl(std::make_unique<Impl>())
 {
@@ -85,21 +81,32 @@ GtpyModule::eval(const QString& code, InputType type) const
 
     if (code.isEmpty()) return true;
 
-    // TODO: Ensure the error handling in this method is thread-safe.
-    // PythonQt::evalScript() clears the error status before the script is
-    // evaluated. This could lead to problems with error handling if the method
-    // is called in multiple threads. The current implementation is based on
-    // the previous implementation of GtpyContextManager::evalScript(). Since
-    // no thread-safety issues with GtpyContextManager::evalScript() have been
-    // observed so far, it might be acceptable to keep this implementation.
-    // However, remember to verify the thread safety again.
-    bool hadError = false;
+    // The success of the evaluation is determined by the result of the
+    // evaluation itself instead of PythonQt::hadError(). The error state of
+    // PythonQt is shared by all threads, so relying on it would require
+    // serializing the evaluations of all modules.
+    bool hadError = true;
+
+    // Equivalent to PythonQt::evalScript(), but if enabled, the compiled
+    // code is taken from the code cache to avoid compiling the same script
+    // again and again.
+    auto codeObj = pimpl->codeCacheEnabled ?
+                       gtpy::codecache::compile(code, type) :
+                       gtpy::codecache::compileUncached(code, type);
+
+    if (codeObj)
+    {
+        auto dict = PyPPModule_GetDict(pimpl->module);
+
+        auto result = PyPPObject::NewRef(
+            PyEval_EvalCode(codeObj.get(), dict.get(), dict.get()));
 
-    PythonQt::self()->evalScript(pimpl->module.get(), code, type);
+        hadError = (result.get() == nullptr);
+    }
 
-    QMutexLocker locker{&Impl::evalMutex};
+    // prints the error and handles SystemExit exceptions
+    if (hadError) PythonQt::self()->handleError();
 
-    hadError = PythonQt::self()->hadError();
     PythonQt::self()->clearError();
 
     return !hadError;
@@ -163,6 +170,18 @@ GtpyModule::loggingPrefix() const
     return pimpl->loggingPrefix;
 }
 
+void
+GtpyModule::setCodeCacheEnabled(bool enable)
+{
+    pimpl->codeCacheEnabled = enable;
+}
+
+bool
+GtpyModule::isCodeCacheEnabled() const
+{
+    return pimpl->codeCacheEnabled;
+}
+
 bool
 GtpyModule::addFunctions(PyMethodDef* def)
 {
@@ -115,6 +115,22 @@ public:
      */
     const QString& loggingPrefix() const;
 
+    /**
+     * @brief Enables or disables the code cache for eval(). If enabled, the
+     * compiled code of evaluated scripts is taken from gtpy::codecache. It is
+     * meant for scripts that are evaluated many times without being changed,
+     * such as the scripts of Python tasks and calculators. It is disabled by
+     * default.
+     * @param enable True if eval() should use the code cache.
+     */
+    void setCodeCacheEnabled(bool enable);
+
+    /**
+     * @brief Returns whether eval() uses the code cache.
+     * @return True if the code cache is enabled.
+     */
+    bool isCodeCacheEnabled() const;
+
     /**
      * @brief Adds a set of functions defined by the provided PyMethodDef
      * array to the Python module associated with this instance. The functions
@@ -0,0 +1,444 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: gtpy_modulescanner.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <algorithm>
+#include <functional>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QSet>
+#include <QStandardPaths>
+
+#include "gtpy_modulescanner.h"
+
+namespace
+{
+
+/// Version of the cache file format. Caches of other versions are ignored.
+constexpr int CACHE_FORMAT = 1;
+
+class ScanRunnable : public QRunnable
+{
+public:
+    explicit ScanRunnable(std::function<void()> func) :
+        m_func(std::move(func))
+    {}
+
+    void run() override { m_func(); }
+
+private:
+    std::function<void()> m_func;
+};
+
+QString
+cacheFile()
+{
+    auto dir = QStandardPaths::writableLocation(
+                QStandardPaths::CacheLocation);
+
+    if (dir.isEmpty()) return {};
+
+    return QDir{dir}.filePath(QStringLiteral("python_modules.json"));
+}
+
+qint64
+lastModified(const QString& path)
+{
+    QFileInfo info{path};
+    return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+quint16
+readUInt16(const char* data)
+{
+    return static_cast<quint16>(static_cast<uchar>(data[0]) |
+                                static_cast<uchar>(data[1]) << 8);
+}
+
+quint32
+readUInt32(const char* data)
+{
+    return static_cast<quint32>(readUInt16(data)) |
+           static_cast<quint32>(readUInt16(data + 2)) << 16;
+}
+
+/**
+ * @brief Returns the names of the files in the given zip archive, e.g. the
+ * zipped standard library or a zipped egg. Only the central directory is
+ * read, which is enough for the names. Archives that are no valid zip files
+ * yield an empty list.
+ */
+QStringList
+zipEntries(const QString& path)
+{
+    // sizes and signatures of the zip format
+    constexpr int endRecordSize = 22;
+    constexpr int maxCommentSize = 0xFFFF;
+    constexpr int dirEntrySize = 46;
+    constexpr quint32 dirEntrySignature = 0x02014b50;
+
+    QFile file{path};
+    if (!file.open(QIODevice::ReadOnly)) return {};
+
+    // the end record is followed by a comment of up to 64 KiB
+    const qint64 tailSize = qMin<qint64>(file.size(),
+                                         endRecordSize + maxCommentSize);
+
+    if (tailSize < endRecordSize || !file.seek(file.size() - tailSize))
+    {
+        return {};
+    }
+
+    const QByteArray tail = file.read(tailSize);
+    const int end = tail.lastIndexOf(QByteArray("PK\x05\x06", 4));
+
+    if (end < 0 || end + endRecordSize > tail.size()) return {};
+
+    const char* record = tail.constData() + end;
+    const quint16 count = readUInt16(record + 10);
+    const quint32 dirSize = readUInt32(record + 12);
+    const quint32 dirOffset = readUInt32(record + 16);
+
+    if (!file.seek(dirOffset)) return {};
+
+    const QByteArray dir = file.read(dirSize);
+    if (static_cast<quint32>(dir.size()) != dirSize) return {};
+
+    QStringList names;
+    int pos = 0;
+
+    for (int i = 0; i < count && pos + dirEntrySize <= dir.size(); ++i)
+    {
+        const char* entry = dir.constData() + pos;
+
+        if (readUInt32(entry) != dirEntrySignature) break;
+
+        const int nameSize = readUInt16(entry + 28);
+        const int extraSize = readUInt16(entry + 30);
+        const int commentSize = readUInt16(entry + 32);
+
+        if (pos + dirEntrySize + nameSize > dir.size()) break;
+
+        names.append(QString::fromUtf8(entry + dirEntrySize, nameSize));
+
+        pos += dirEntrySize + nameSize + extraSize + commentSize;
+    }
+
+    return names;
+}
+
+/**
+ * @brief Returns the module name of the given file name or an empty string
+ * if it is no Python module. It corresponds to inspect.getmodulename() for
+ * source, bytecode and extension modules.
+ */
+QString
+moduleName(const QString& fileName)
+{
+    static const QStringList sourceSuffixes{
+        QStringLiteral(".py"), QStringLiteral(".pyw"), QStringLiteral(".pyc")
+    };
+
+    for (const auto& suffix : sourceSuffixes)
+    {
+        if (fileName.endsWith(suffix))
+        {
+            return fileName.left(fileName.size() - suffix.size());
+        }
+    }
+
+    static const QStringList extensionSuffixes{
+        QStringLiteral(".so"), QStringLiteral(".pyd")
+    };
+
+    for (const auto& suffix : extensionSuffixes)
+    {
+        if (!fileName.endsWith(suffix)) continue;
+
+        auto name = fileName.left(fileName.size() - suffix.size());
+
+        // e.g. name.cpython-39-x86_64-linux-gnu.so or name.cp39-win_amd64.pyd
+        const int dot = name.indexOf('.');
+        if (dot == -1) return name;
+
+        const auto tag = name.mid(dot + 1);
+        if (tag.startsWith(QStringLiteral("cp")) ||
+            tag.startsWith(QStringLiteral("abi")))
+        {
+            return name.left(dot);
+        }
+
+        return {};
+    }
+
+    return {};
+}
+
+bool
+isPackage(const QString& path)
+{
+    const auto entries = QDir{path}.entryList(QDir::Files);
+
+    return std::any_of(entries.cbegin(), entries.cend(),
+                       [](const QString& fileName){
+        return moduleName(fileName) == QStringLiteral("__init__");
+    });
+}
+
+} // namespace
+
+GtpyModuleScanner::GtpyModuleScanner(QObject* parent) : QObject(parent)
+{
+    m_pool.setMaxThreadCount(1);
+
+    loadCache();
+}
+
+void
+GtpyModuleScanner::setPaths(const QStringList& paths)
+{
+    auto newPaths = paths;
+    newPaths.removeDuplicates();
+
+    if (newPaths == m_paths) return;
+
+    m_paths = newPaths;
+
+    for (const auto& path : qAsConst(m_paths))
+    {
+        auto iter = m_entries.constFind(path);
+
+        if (iter == m_entries.cend() ||
+            iter->lastModified != lastModified(path))
+        {
+            startScan(path);
+        }
+    }
+
+    // cached directories contribute to the result immediately
+    emit modulesChanged();
+}
+
+const QStringList&
+GtpyModuleScanner::paths() const
+{
+    return m_paths;
+}
+
+void
+GtpyModuleScanner::rescan(const QString& path)
+{
+    if (m_paths.contains(path)) startScan(path);
+}
+
+QStringList
+GtpyModuleScanner::modules() const
+{
+    QSet<QString> names;
+
+    for (const auto& path : m_paths)
+    {
+        auto iter = m_entries.constFind(path);
+        if (iter == m_entries.cend()) continue;
+
+        for (const auto& name : iter->modules) names.insert(name);
+    }
+
+    QStringList retval = names.values();
+    retval.sort();
+
+    return retval;
+}
+
+QStringList
+GtpyModuleScanner::scanArchive(const QString& path)
+{
+    QSet<QString> names;
+
+    const auto entries = zipEntries(path);
+
+    for (const auto& entry : entries)
+    {
+        const auto parts = entry.split('/');
+
+        QString name;
+
+        if (parts.size() == 1)
+        {
+            name = moduleName(parts.first());
+        }
+        else if (parts.size() == 2 &&
+                 moduleName(parts.last()) == QStringLiteral("__init__"))
+        {
+            name = parts.first();
+        }
+
+        if (name.isEmpty() || name == QStringLiteral("__init__") ||
+            name.contains('.'))
+        {
+            continue;
+        }
+
+        names.insert(name);
+    }
+
+    QStringList retval = names.values();
+    retval.sort();
+
+    return retval;
+}
+
+QStringList
+GtpyModuleScanner::scanDirectory(const QString& path)
+{
+    // zip archives and zipped eggs on sys.path are imported by zipimport
+    if (QFileInfo{path}.isFile()) return scanArchive(path);
+
+    QDir dir{path};
+    if (!dir.exists()) return {};
+
+    QSet<QString> names;
+
+    const auto entries = dir.entryInfoList(QDir::Files | QDir::Dirs |
+                                           QDir::NoDotAndDotDot);
+
+    for (const auto& info : entries)
+    {
+        const auto fileName = info.fileName();
+
+        QString name = info.isDir() ? QString{} : moduleName(fileName);
+
+        if (info.isDir())
+        {
+            if (fileName.contains('.') ||
+                !isPackage(info.absoluteFilePath()))
+            {
+                continue;
+            }
+
+            name = fileName;
+        }
+
+        if (name.isEmpty() || name == QStringLiteral("__init__") ||
+            name.contains('.'))
+        {
+            continue;
+        }
+
+        names.insert(name);
+    }
+
+    QStringList retval = names.values();
+    retval.sort();
+
+    return retval;
+}
+
+void
+GtpyModuleScanner::startScan(const QString& path)
+{
+    m_pool.start(new ScanRunnable([this, path](){
+        Entry entry;
+
+        // read the time first, so that changes during the scan trigger
+        // another scan on the next start
+        entry.lastModified = lastModified(path);
+        entry.modules = scanDirectory(path);
+
+        // the pool is destroyed before the scanner, so this is still valid
+        QMetaObject::invokeMethod(this, [this, path, entry](){
+            onScanned(path, entry);
+        }, Qt::QueuedConnection);
+    }));
+}
+
+void
+GtpyModuleScanner::onScanned(const QString& path, const Entry& entry)
+{
+    auto& current = m_entries[path];
+
+    const bool changed = current.modules != entry.modules;
+    const bool stampChanged = current.lastModified != entry.lastModified;
+
+    current = entry;
+
+    if (changed || stampChanged) storeCache();
+
+    if (changed && m_paths.contains(path)) emit modulesChanged();
+}
+
+void
+GtpyModuleScanner::loadCache()
+{
+    const auto fileName = cacheFile();
+    if (fileName.isEmpty()) return;
+
+    QFile file{fileName};
+    if (!file.open(QIODevice::ReadOnly)) return;
+
+    const auto cache = QJsonDocument::fromJson(file.readAll()).object();
+
+    if (cache.value("format").toInt() != CACHE_FORMAT) return;
+
+    const auto paths = cache.value("paths").toObject();
+
+    for (auto iter = paths.constBegin(); iter != paths.constEnd(); ++iter)
+    {
+        const auto obj = iter.value().toObject();
+
+        Entry entry;
+        entry.lastModified = obj.value("lastModified").toVariant()
+                .toLongLong();
+
+        for (const auto& name : obj.value("modules").toArray())
+        {
+            entry.modules.append(name.toString());
+        }
+
+        m_entries.insert(iter.key(), entry);
+    }
+}
+
+void
+GtpyModuleScanner::storeCache() const
+{
+    const auto fileName = cacheFile();
+    if (fileName.isEmpty()) return;
+
+    QJsonObject paths;
+
+    for (auto iter = m_entries.cbegin(); iter != m_entries.cend(); ++iter)
+    {
+        QJsonObject obj;
+        obj.insert("lastModified", iter->lastModified);
+        obj.insert("modules", QJsonArray::fromStringList(iter->modules));
+
+        paths.insert(iter.key(), obj);
+    }
+
+    QJsonObject cache;
+    cache.insert("format", CACHE_FORMAT);
+    cache.insert("paths", paths);
+
+    QDir{}.mkpath(QFileInfo{fileName}.absolutePath());
+
+    // several GTlab instances may write the cache at the same time
+    QSaveFile file{fileName};
+    if (!file.open(QIODevice::WriteOnly)) return;
+
+    file.write(QJsonDocument{cache}.toJson(QJsonDocument::Compact));
+    file.commit();
+}
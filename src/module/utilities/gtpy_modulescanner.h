@@ -0,0 +1,134 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: gtpy_modulescanner.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#ifndef GTPY_MODULESCANNER_H
+#define GTPY_MODULESCANNER_H
+
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+#include <QThreadPool>
+
+#include "gt_pythonmodule_exports.h"
+
+/**
+ * @brief Collects the names of the top-level modules that can be imported
+ * from the directories and zip archives of sys.path. The paths are scanned
+ * in a background thread without the GIL. The results are cached on disk per
+ * path and reused as long as the modification time of the path does not
+ * change.
+ *
+ * The scanner must only be used from the thread it lives in.
+ */
+class GT_PYTHON_EXPORT GtpyModuleScanner : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor. Loads the cached scan results.
+     * @param parent Parent object.
+     */
+    explicit GtpyModuleScanner(QObject* parent = nullptr);
+
+    /**
+     * @brief Sets the directories to scan. Directories that are not cached or
+     * whose modification time changed are scanned in the background.
+     * @param paths Directories of sys.path.
+     */
+    void setPaths(const QStringList& paths);
+
+    /**
+     * @brief Returns the directories to scan.
+     * @return Directories to scan.
+     */
+    const QStringList& paths() const;
+
+    /**
+     * @brief Scans the given directory again if it is one of the scanned
+     * directories.
+     * @param path Directory to scan.
+     */
+    void rescan(const QString& path);
+
+    /**
+     * @brief Returns the sorted names of all modules found in the scanned
+     * directories so far.
+     * @return Names of the importable modules.
+     */
+    QStringList modules() const;
+
+    /**
+     * @brief Returns the names of the top-level modules and packages in the
+     * given directory like pkgutil.iter_modules does. Packages must contain
+     * an __init__ module. If the path is a file, it is scanned as zip archive
+     * (see scanArchive()).
+     * @param path Directory to scan.
+     * @return Sorted names of the modules in the directory.
+     */
+    static QStringList scanDirectory(const QString& path);
+
+    /**
+     * @brief Returns the names of the top-level modules and packages in the
+     * given zip archive, e.g. a zipped standard library or egg on sys.path.
+     * @param path Archive to scan.
+     * @return Sorted names of the modules in the archive.
+     */
+    static QStringList scanArchive(const QString& path);
+
+signals:
+    /**
+     * @brief Emitted when the scan of a directory changed the result of
+     * modules().
+     */
+    void modulesChanged();
+
+private:
+    struct Entry
+    {
+        qint64 lastModified{-1};
+        QStringList modules;
+    };
+
+    /**
+     * @brief Scans the given directory in the background.
+     * @param path Directory to scan.
+     */
+    void startScan(const QString& path);
+
+    /**
+     * @brief Stores the scan result of the given directory.
+     * @param path Scanned directory.
+     * @param entry Scan result.
+     */
+    void onScanned(const QString& path, const Entry& entry);
+
+    /**
+     * @brief Loads the cached scan results from disk.
+     */
+    void loadCache();
+
+    /**
+     * @brief Writes the scan results to disk.
+     */
+    void storeCache() const;
+
+    /// Directories to scan
+    QStringList m_paths;
+
+    /// Scan results by directory, including cached directories that are
+    /// currently not scanned
+    QHash<QString, Entry> m_entries;
+
+    /// Scans of the directories. It is destroyed first and waits for the
+    /// running scans.
+    QThreadPool m_pool;
+};
+
+#endif // GTPY_MODULESCANNER_H
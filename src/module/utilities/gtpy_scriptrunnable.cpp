@@ -35,7 +35,15 @@ GtpyScriptRunnable::run()
 
     m_successfulRun = python->evalScript(m_contextId,
                                          m_script,
-                                         m_outputToConsole);
+                                         m_outputToConsole,
+                                         true,
+                                         m_evalOption);
+
+    // the pool thread may evaluate other scripts later on
+    m_mutex.lock();
+    m_threadId = 0;
+    m_mutex.unlock();
+
     emit runnableFinished();
 }
 
@@ -61,6 +69,12 @@ void GtpyScriptRunnable::setOutputToConsole(bool outputToConsole)
     m_outputToConsole = outputToConsole;
 }
 
+void
+GtpyScriptRunnable::setEvalOption(const GtpyContextManager::EvalOptions& option)
+{
+    m_evalOption = option;
+}
+
 bool
 GtpyScriptRunnable::successful()
 {
@@ -76,7 +90,10 @@ GtpyScriptRunnable::interrupt()
 
     m_successfulRun = false;
 
-    GtpyContextManager::instance()->interruptPyThread(m_threadId);
+    if (m_threadId != 0)
+    {
+        GtpyContextManager::instance()->interruptPyThread(m_threadId);
+    }
 
     m_mutex.unlock();
 }
@@ -69,6 +69,13 @@ public:
      */
     void setOutputToConsole(bool outputToConsole);
 
+    /**
+     * @brief Sets the option used to evaluate the script. The default is
+     * GtpyContextManager::EvalFile.
+     * @param option Evaluation option.
+     */
+    void setEvalOption(const GtpyContextManager::EvalOptions& option);
+
     /**
      * @brief Returns whether the script evaluation was successful or not.
      * @return Whether the script evaluation was successful or not.
@@ -82,13 +89,16 @@ private:
     /// Output behaviore
     bool m_outputToConsole;
 
+    /// Evaluation option
+    GtpyContextManager::EvalOptions m_evalOption{GtpyContextManager::EvalFile};
+
     /// Evaluation success
     bool m_successfulRun;
 
     /// Mutex
     QMutex m_mutex;
 
-    /// Current python thread id
+    /// Current python thread id, 0 if the script is not evaluated
     long m_threadId;
 
     /// Python context identifier
@@ -5,6 +5,7 @@
  */
 
 #include "gtpy_taskapi.h"
+#include "gtpy_childindex.h"
 
 #include <gt_application.h>
 #include <gt_project.h>
@@ -136,9 +137,9 @@ getTask(GtProcessData* data, TaskSpec spec)
         return nullptr;
     }
 
-    return group->findDirectChild<GtTask*>(spec.taskId);
+    return gtpy::childindex::findChild<GtTask*>(group, spec.taskId);
 #else
-    return data->findDirectChild<GtTask*>(spec.taskId);
+    return gtpy::childindex::findChild<GtTask*>(data, spec.taskId);
 #endif
 }
 
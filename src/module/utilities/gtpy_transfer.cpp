@@ -57,9 +57,8 @@ gtpy::transfer::removeGtObjectFromPython(int contextId, GtObject* obj)
 }
 
 #if GT_VERSION >= GT_VERSION_CHECK(2, 0, 0)
-void
-gtpy::transfer::propStructToPython(
-        int contextId, const GtPropertyStructContainer& container)
+QVariantMap
+gtpy::transfer::propStructToMap(const GtPropertyStructContainer& container)
 {
     QVariantMap dict;
 
@@ -83,17 +82,13 @@ gtpy::transfer::propStructToPython(
         }
     }
 
-    GtpyContextManager::instance()->addVariable(
-                contextId, container.ident(), dict);
+    return dict;
 }
 
 void
-gtpy::transfer::propStructFromPython(
-        int contextId, GtPropertyStructContainer& container)
+gtpy::transfer::propStructFromMap(
+        const QVariantMap& dict, GtPropertyStructContainer& container)
 {
-    QVariantMap dict = GtpyContextManager::instance()->getVariable(
-                contextId, container.ident()).toMap();
-
     for (auto& entry : container)
     {
 #if GT_VERSION >= GT_VERSION_CHECK(2, 1, 0)
@@ -109,4 +104,22 @@ gtpy::transfer::propStructFromPython(
         }
     }
 }
+
+void
+gtpy::transfer::propStructToPython(
+        int contextId, const GtPropertyStructContainer& container)
+{
+    GtpyContextManager::instance()->addVariable(
+                contextId, container.ident(), propStructToMap(container));
+}
+
+void
+gtpy::transfer::propStructFromPython(
+        int contextId, GtPropertyStructContainer& container)
+{
+    QVariantMap dict = GtpyContextManager::instance()->getVariable(
+                contextId, container.ident()).toMap();
+
+    propStructFromMap(dict, container);
+}
 #endif
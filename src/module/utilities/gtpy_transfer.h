@@ -12,6 +12,7 @@
 #define GTPYUTILITIES_H
 
 #include <QString>
+#include <QVariantMap>
 
 #include "gt_globals.h"
 
@@ -57,6 +58,23 @@ void removeObjectFromPython(int contextId, const QString& varName);
 void removeGtObjectFromPython(int contextId,  GtObject* obj);
 
 #if GT_VERSION >= GT_VERSION_CHECK(2, 0, 0)
+/**
+ * @brief Returns a map containing the values of the property struct
+ * container identified by their names.
+ * @param container Property struct container.
+ * @return Values of the property struct container.
+ */
+QVariantMap propStructToMap(const GtPropertyStructContainer& container);
+
+/**
+ * @brief Puts the values of the given map into the property struct
+ * container. Entries without a matching name are ignored.
+ * @param dict Values identified by their names.
+ * @param container Property struct container.
+ */
+void propStructFromMap(
+        const QVariantMap& dict, GtPropertyStructContainer& container);
+
 /**
  * @brief Creates a dict containing the values of the property struct container.
  * @param contextId Id of the Python context to add the dict.
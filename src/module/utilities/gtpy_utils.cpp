@@ -73,3 +73,13 @@ gtpy::utils::projectPyScriptsPath(const GtProject* project)
     auto path = dir.absoluteFilePath(gtpy::constants::PROJ_PY_SCRIPTS_DIR);
     return QDir::toNativeSeparators(path);
 }
+
+QString
+gtpy::utils::projectPyCachePath(const GtProject* project)
+{
+    if (!project) return {};
+
+    QDir dir{project->path()};
+    auto path = dir.absoluteFilePath(gtpy::constants::PROJ_PY_CACHE_DIR);
+    return QDir::toNativeSeparators(path);
+}
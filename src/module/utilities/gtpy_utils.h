@@ -45,6 +45,14 @@ void removeFromSysPath(const QString& path);
  */
 QString projectPyScriptsPath(const GtProject* project);
 
+/**
+ * @brief Returns the absolute path to the directory inside the given
+ * project's root directory, where compiled Python code is cached.
+ * @param project Pointer to the GtProject instance.
+ * @return Absolute path to the Python code cache directory.
+ */
+QString projectPyCachePath(const GtProject* project);
+
 
 } // namespace utils
 
@@ -0,0 +1,639 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: gtpy_workerpool.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+#include <QDir>
+#include <QUuid>
+#include <QThread>
+#include <QProcess>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QStandardPaths>
+#include <QCoreApplication>
+
+#include "gt_logging.h"
+#include "gt_objectfactory.h"
+#include "gt_objectmemento.h"
+
+#include "gtpy_task.h"
+#include "gtpy_transfer.h"
+#include "gtpy_contextmanager.h"
+
+#include "gtpy_workerpool.h"
+
+namespace {
+
+enum MessageType : quint8
+{
+    EvaluateMessage = 1,
+    ShutdownMessage = 2
+};
+
+/// Time a new worker may take to start up and listen for connections
+constexpr int STARTUP_TIMEOUT_MS = 120000;
+
+/// Timeout for connecting to and writing to a running worker
+constexpr int IO_TIMEOUT_MS = 10000;
+
+/// Workers terminate after being idle for this time
+constexpr int IDLE_TIMEOUT_MS = 600000;
+
+/// Interval in which canceled requests are detected
+constexpr int CANCEL_POLL_MS = 200;
+
+constexpr const char* INPUT_ARGS = "input_args";
+constexpr const char* OUTPUT_ARGS = "output_args";
+
+constexpr QDataStream::Version STREAM_VERSION = QDataStream::Qt_5_6;
+
+/**
+ * @brief Returns the full name of the local server with the given name.
+ * Relative names are placed in the runtime directory of the user, which only
+ * the user can access, so that other users can neither connect to a server
+ * nor occupy its name. Pipe names on Windows are kept, they are protected by
+ * the socket options of the server.
+ * @param name Name of the server.
+ * @return Full name of the server.
+ */
+QString
+localServerName(const QString& name)
+{
+#ifdef Q_OS_WIN
+    return name;
+#else
+    if (QDir::isAbsolutePath(name)) return name;
+
+    const QString dir = QStandardPaths::writableLocation(
+        QStandardPaths::RuntimeLocation);
+
+    return dir.isEmpty() ? name : QDir{dir}.filePath(name);
+#endif
+}
+
+bool
+writeMessage(QLocalSocket& socket, const QByteArray& payload)
+{
+    QByteArray frame;
+    QDataStream out{&frame, QIODevice::WriteOnly};
+    out.setVersion(STREAM_VERSION);
+    out << payload;
+
+    if (socket.write(frame) != frame.size()) return false;
+
+    while (socket.bytesToWrite() > 0)
+    {
+        if (!socket.waitForBytesWritten(IO_TIMEOUT_MS)) return false;
+    }
+
+    return true;
+}
+
+bool
+waitForBytes(QLocalSocket& socket, qint64 count, int msecs)
+{
+    while (socket.bytesAvailable() < count)
+    {
+        if (!socket.waitForReadyRead(msecs)) return false;
+    }
+
+    return true;
+}
+
+bool
+readMessage(QLocalSocket& socket, QByteArray& payload, int msecs)
+{
+    if (!waitForBytes(socket, sizeof(quint32), msecs)) return false;
+
+    quint32 size{0};
+    {
+        QDataStream in{socket.read(sizeof(quint32))};
+        in.setVersion(STREAM_VERSION);
+        in >> size;
+    }
+
+    if (!waitForBytes(socket, size, msecs)) return false;
+
+    payload = socket.read(size);
+
+    return payload.size() == static_cast<int>(size);
+}
+
+/**
+ * @brief Waits until the response starts to arrive. If the given function
+ * returns true in the meantime, waiting is canceled.
+ * @param socket Socket connected to the worker.
+ * @param canceled Polled cancellation function. May be empty.
+ * @param wasCanceled Set to true if waiting was canceled.
+ * @return True if data is available.
+ */
+bool
+waitForResponse(QLocalSocket& socket, const std::function<bool()>& canceled,
+                bool& wasCanceled)
+{
+    while (socket.bytesAvailable() <= 0)
+    {
+        if (canceled && canceled())
+        {
+            wasCanceled = true;
+            return false;
+        }
+
+        if (!socket.waitForReadyRead(canceled ? CANCEL_POLL_MS : -1) &&
+            socket.state() != QLocalSocket::ConnectedState) return false;
+    }
+
+    return true;
+}
+
+bool
+connectToWorker(QLocalSocket& socket, const QString& serverName, int msecs)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // a newly started worker needs some time until it is listening
+    forever
+    {
+        socket.connectToServer(localServerName(serverName));
+
+        if (socket.waitForConnected(IO_TIMEOUT_MS)) return true;
+
+        if (timer.elapsed() > msecs) return false;
+
+        QThread::msleep(100);
+    }
+}
+
+bool
+sendShutdown(const QString& serverName)
+{
+    QLocalSocket socket;
+    socket.connectToServer(localServerName(serverName));
+
+    if (!socket.waitForConnected(IO_TIMEOUT_MS)) return false;
+
+    QByteArray payload;
+    QDataStream out{&payload, QIODevice::WriteOnly};
+    out.setVersion(STREAM_VERSION);
+    out << static_cast<quint8>(ShutdownMessage);
+
+    return writeMessage(socket, payload);
+}
+
+GtpyWorkerResponse
+sendRequest(const QString& serverName, const GtpyWorkerRequest& request,
+            int connectTimeout, const std::function<bool()>& canceled = {})
+{
+    QByteArray payload;
+    {
+        QDataStream out{&payload, QIODevice::WriteOnly};
+        out.setVersion(STREAM_VERSION);
+        out << static_cast<quint8>(EvaluateMessage) << request;
+    }
+
+    QLocalSocket socket;
+    QByteArray reply;
+    bool wasCanceled{false};
+
+    // the evaluation itself may take arbitrarily long, so there is no
+    // timeout for the response. A crashed worker closes the connection.
+    bool ok = connectToWorker(socket, serverName, connectTimeout) &&
+              writeMessage(socket, payload) &&
+              waitForResponse(socket, canceled, wasCanceled) &&
+              readMessage(socket, reply, -1);
+
+    GtpyWorkerResponse response;
+
+    if (ok)
+    {
+        QDataStream in{reply};
+        in.setVersion(STREAM_VERSION);
+        in >> response;
+
+        ok = in.status() == QDataStream::Ok;
+    }
+
+    if (!ok)
+    {
+        response = GtpyWorkerResponse{};
+        response.error = wasCanceled ?
+                    QObject::tr("Python worker process '%1' was terminated")
+                        .arg(serverName) :
+                    QObject::tr("Python worker process '%1' crashed or "
+                                "could not be reached").arg(serverName);
+    }
+
+    return response;
+}
+
+GtpyWorkerResponse
+evaluate(const GtpyWorkerRequest& request)
+{
+    GtpyWorkerResponse response;
+
+    auto* ctxMgr = GtpyContextManager::instance();
+
+    int contextId = ctxMgr->createNewContext(
+        request.batch ? GtpyContextManager::BatchContext :
+                        GtpyContextManager::TaskRunContext, true);
+
+    ctxMgr->setLoggingPrefix(contextId, request.loggingPrefix);
+
+    // collect the output of the script to send it back to the main process
+    auto outConn = QObject::connect(
+        ctxMgr, &GtpyContextManager::pythonMessage,
+        [&](const QString& message, int id, const QString&){
+        if (id == contextId) response.output.append(message);
+    });
+
+    auto errConn = QObject::connect(
+        ctxMgr, &GtpyContextManager::errorMessage,
+        [&](const QString& message, int id, const QString&){
+        if (id == contextId) response.errors.append(message);
+    });
+
+    if (request.batch)
+    {
+        response.success = ctxMgr->evalScript(contextId, request.script,
+                                              true);
+
+        ctxMgr->deleteContext(contextId, true);
+
+        QObject::disconnect(outConn);
+        QObject::disconnect(errConn);
+
+        return response;
+    }
+
+    std::vector<std::unique_ptr<GtObject>> packages;
+    packages.reserve(request.packages.size());
+
+    for (const auto& data : request.packages)
+    {
+        GtObject* pkg{nullptr};
+
+        if (!data.isEmpty())
+        {
+            GtObjectMemento memento{data};
+            pkg = memento.restore<GtObject*>(gtObjectFactory);
+        }
+
+        gtpy::transfer::gtObjectToPython(contextId, pkg);
+        packages.emplace_back(pkg);
+    }
+
+    // calculators created by the script are appended to a local task
+    GtpyTask task;
+    task.setObjectName(request.loggingPrefix);
+    ctxMgr->addTaskValue(contextId, &task);
+
+    ctxMgr->addVariable(contextId, INPUT_ARGS, request.inputArgs);
+    ctxMgr->addVariable(contextId, OUTPUT_ARGS, request.outputArgs);
+
+    response.success = ctxMgr->evalScript(contextId, request.script, true);
+
+    response.outputArgs = ctxMgr->getVariable(contextId, OUTPUT_ARGS).toMap();
+
+    for (const auto& pkg : packages)
+    {
+        gtpy::transfer::removeGtObjectFromPython(contextId, pkg.get());
+
+        response.packages.append(pkg ? pkg->toMemento().toByteArray()
+                                     : QByteArray{});
+    }
+
+    ctxMgr->deleteContext(contextId, true);
+
+    QObject::disconnect(outConn);
+    QObject::disconnect(errConn);
+
+    return response;
+}
+
+} // namespace
+
+QDataStream&
+operator<<(QDataStream& out, const GtpyWorkerRequest& request)
+{
+    return out << request.script << request.loggingPrefix << request.packages
+               << request.inputArgs << request.outputArgs << request.batch;
+}
+
+QDataStream&
+operator>>(QDataStream& in, GtpyWorkerRequest& request)
+{
+    return in >> request.script >> request.loggingPrefix >> request.packages
+              >> request.inputArgs >> request.outputArgs >> request.batch;
+}
+
+QDataStream&
+operator<<(QDataStream& out, const GtpyWorkerResponse& response)
+{
+    return out << response.success << response.error << response.packages
+               << response.outputArgs << response.output << response.errors;
+}
+
+QDataStream&
+operator>>(QDataStream& in, GtpyWorkerResponse& response)
+{
+    return in >> response.success >> response.error >> response.packages
+              >> response.outputArgs >> response.output >> response.errors;
+}
+
+GtpyWorkerPool*
+GtpyWorkerPool::instance()
+{
+    // Intentionally leaked: workers may still be connected while the
+    // application shuts down.
+    static auto* pool = new GtpyWorkerPool;
+    return pool;
+}
+
+void
+GtpyWorkerPool::setWorkerCount(int count)
+{
+    QMutexLocker locker(&m_mutex);
+    m_workerCount = std::max(0, count);
+}
+
+int
+GtpyWorkerPool::workerCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_workerCount;
+}
+
+bool
+GtpyWorkerPool::isEnabled() const
+{
+    return workerCount() > 0;
+}
+
+void
+GtpyWorkerPool::setWorkerCommand(const QString& program,
+                                 const QStringList& args)
+{
+    QMutexLocker locker(&m_mutex);
+    m_program = program;
+    m_programArgs = args;
+}
+
+GtpyWorkerResponse
+GtpyWorkerPool::run(const GtpyWorkerRequest& request,
+                    const std::function<bool()>& canceled)
+{
+    const auto serverName = acquireWorker();
+
+    if (serverName.isEmpty())
+    {
+        GtpyWorkerResponse response;
+        response.error = QObject::tr("Could not start a Python worker "
+                                     "process");
+        return response;
+    }
+
+    auto response = sendRequest(serverName, request, STARTUP_TIMEOUT_MS,
+                                canceled);
+
+    // a canceled or crashed worker is killed
+    releaseWorker(serverName, !response.error.isEmpty());
+
+    return response;
+}
+
+GtpyWorkerResponse
+GtpyWorkerPool::request(const QString& serverName,
+                        const GtpyWorkerRequest& request)
+{
+    return sendRequest(serverName, request, IO_TIMEOUT_MS);
+}
+
+void
+GtpyWorkerPool::shutdown()
+{
+    QStringList idle;
+    QStringList busy;
+
+    {
+        QMutexLocker locker(&m_mutex);
+
+        for (const auto& worker : qAsConst(m_workers))
+        {
+            (worker.busy ? busy : idle).append(worker.serverName);
+        }
+
+        m_workers.clear();
+        m_workerCount = 0;
+
+        m_workerIdle.wakeAll();
+    }
+
+    for (const auto& serverName : qAsConst(idle))
+    {
+        if (!sendShutdown(serverName)) killProcess(serverName);
+    }
+
+    for (const auto& serverName : qAsConst(busy)) killProcess(serverName);
+}
+
+int
+GtpyWorkerPool::serve(const QString& serverName, bool resident)
+{
+    QLocalServer server;
+    server.setSocketOptions(QLocalServer::UserAccessOption);
+
+    if (!server.listen(localServerName(serverName)))
+    {
+        gtError() << QObject::tr("Python worker could not listen on")
+                  << serverName << ":" << server.errorString();
+        return -1;
+    }
+
+    forever
+    {
+        bool timedOut{false};
+
+        if (!server.waitForNewConnection(resident ? -1 : IDLE_TIMEOUT_MS,
+                                         &timedOut))
+        {
+            return timedOut ? 0 : -1;
+        }
+
+        std::unique_ptr<QLocalSocket> socket{server.nextPendingConnection()};
+
+        QByteArray payload;
+        if (!socket || !readMessage(*socket, payload, IO_TIMEOUT_MS)) continue;
+
+        QDataStream in{payload};
+        in.setVersion(STREAM_VERSION);
+
+        quint8 type{0};
+        in >> type;
+
+        if (type == ShutdownMessage) return 0;
+
+        GtpyWorkerRequest request;
+        in >> request;
+
+        if (type != EvaluateMessage || in.status() != QDataStream::Ok)
+        {
+            continue;
+        }
+
+        QByteArray reply;
+        {
+            QDataStream out{&reply, QIODevice::WriteOnly};
+            out.setVersion(STREAM_VERSION);
+            out << evaluate(request);
+        }
+
+        writeMessage(*socket, reply);
+        socket->disconnectFromServer();
+    }
+}
+
+QString
+GtpyWorkerPool::acquireWorker()
+{
+    QMutexLocker locker(&m_mutex);
+
+    forever
+    {
+        for (auto& worker : m_workers)
+        {
+            if (!worker.busy)
+            {
+                worker.busy = true;
+                return worker.serverName;
+            }
+        }
+
+        if (m_workers.size() < m_workerCount)
+        {
+            // the random part keeps the name from being guessed in advance
+            const auto serverName = QStringLiteral("gtpy-worker-%1-%2-%3")
+                    .arg(QCoreApplication::applicationPid())
+                    .arg(++m_serial)
+                    .arg(QUuid::createUuid().toString(QUuid::Id128));
+
+            if (!startProcess(serverName)) return {};
+
+            m_workers.append({serverName, true});
+            return serverName;
+        }
+
+        if (m_workerCount <= 0) return {};
+
+        m_workerIdle.wait(&m_mutex);
+    }
+}
+
+void
+GtpyWorkerPool::releaseWorker(const QString& serverName, bool broken)
+{
+    bool surplus{false};
+
+    {
+        QMutexLocker locker(&m_mutex);
+
+        auto iter = std::find_if(m_workers.begin(), m_workers.end(),
+                                 [&](const Worker& w){
+            return w.serverName == serverName;
+        });
+
+        if (iter == m_workers.end()) return;
+
+        surplus = !broken && m_workers.size() > m_workerCount;
+
+        if (broken || surplus)
+        {
+            m_workers.erase(iter);
+        }
+        else
+        {
+            iter->busy = false;
+        }
+
+        m_workerIdle.wakeOne();
+    }
+
+    if (broken) killProcess(serverName);
+    else if (surplus && !sendShutdown(serverName)) killProcess(serverName);
+}
+
+bool
+GtpyWorkerPool::startProcess(const QString& serverName)
+{
+    // expects m_mutex to be locked
+    if (!m_processThread)
+    {
+        // Intentionally leaked together with the pool
+        m_processThread = new QThread;
+        m_processThread->setObjectName(QStringLiteral("GtpyWorkerProcesses"));
+        m_processThread->start();
+
+        m_processOwner = new QObject;
+        m_processOwner->moveToThread(m_processThread);
+    }
+
+    const auto program = m_program.isEmpty() ?
+                QCoreApplication::applicationFilePath() : m_program;
+
+    const auto args = QStringList{m_programArgs} << WORKER_ARG << serverName;
+
+    auto* owner = m_processOwner;
+    bool started{false};
+
+    // the lambda does not lock m_mutex, so blocking here cannot deadlock
+    QMetaObject::invokeMethod(owner, [&](){
+        auto* process = new QProcess(owner);
+        process->setObjectName(serverName);
+        process->setProcessChannelMode(QProcess::ForwardedChannels);
+
+        QObject::connect(process,
+                         SIGNAL(finished(int,QProcess::ExitStatus)),
+                         process, SLOT(deleteLater()));
+
+        process->start(program, args);
+
+        started = process->waitForStarted(IO_TIMEOUT_MS);
+
+        if (!started) delete process;
+    }, Qt::BlockingQueuedConnection);
+
+    return started;
+}
+
+void
+GtpyWorkerPool::killProcess(const QString& serverName)
+{
+    QObject* owner{nullptr};
+
+    {
+        QMutexLocker locker(&m_mutex);
+        owner = m_processOwner;
+    }
+
+    if (!owner) return;
+
+    QMetaObject::invokeMethod(owner, [owner, serverName](){
+        auto* process = owner->findChild<QProcess*>(
+            serverName, Qt::FindDirectChildrenOnly);
+
+        if (process && process->state() != QProcess::NotRunning)
+        {
+            process->kill();
+        }
+    }, Qt::QueuedConnection);
+}
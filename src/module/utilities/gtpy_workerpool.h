@@ -0,0 +1,269 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: gtpy_workerpool.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#ifndef GTPY_WORKERPOOL_H
+#define GTPY_WORKERPOOL_H
+
+#include <functional>
+
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QByteArray>
+#include <QStringList>
+#include <QVariantMap>
+#include <QWaitCondition>
+
+#include "gt_pythonmodule_exports.h"
+
+class QDataStream;
+class QThread;
+class QObject;
+
+/**
+ * @brief The GtpyWorkerRequest struct describes one script evaluation that
+ * is dispatched to a worker process. All data required by the script is
+ * transferred in a single message.
+ */
+struct GT_PYTHON_EXPORT GtpyWorkerRequest
+{
+    /// Python script to evaluate
+    QString script;
+
+    /// Prefix of the log messages emitted by the script
+    QString loggingPrefix;
+
+    /// Serialized mementos of the data packages accessible by the script
+    QList<QByteArray> packages;
+
+    /// Values of the input_args dict
+    QVariantMap inputArgs;
+
+    /// Initial values of the output_args dict
+    QVariantMap outputArgs;
+
+    /// If true, the script is evaluated as a batch script in a new batch
+    /// context. Packages and arguments are ignored in this case.
+    bool batch{false};
+};
+
+/**
+ * @brief The GtpyWorkerResponse struct holds the result of a script
+ * evaluation in a worker process.
+ */
+struct GT_PYTHON_EXPORT GtpyWorkerResponse
+{
+    /// Whether the script was evaluated successfully
+    bool success{false};
+
+    /// Description of a transport error (e.g. a crashed worker). It is
+    /// empty if the worker returned a response.
+    QString error;
+
+    /// Serialized mementos of the data packages after the evaluation. The
+    /// order matches the order of GtpyWorkerRequest::packages.
+    QList<QByteArray> packages;
+
+    /// Values of the output_args dict after the evaluation
+    QVariantMap outputArgs;
+
+    /// Standard output of the script
+    QStringList output;
+
+    /// Error output of the script
+    QStringList errors;
+};
+
+GT_PYTHON_EXPORT QDataStream& operator<<(QDataStream& out,
+                                         const GtpyWorkerRequest& request);
+GT_PYTHON_EXPORT QDataStream& operator>>(QDataStream& in,
+                                         GtpyWorkerRequest& request);
+GT_PYTHON_EXPORT QDataStream& operator<<(QDataStream& out,
+                                         const GtpyWorkerResponse& response);
+GT_PYTHON_EXPORT QDataStream& operator>>(QDataStream& in,
+                                         GtpyWorkerResponse& response);
+
+/**
+ * @brief The GtpyWorkerPool class dispatches script evaluations of Python
+ * tasks to a pool of worker processes. Each worker embeds its own Python
+ * interpreter, so that scripts of tasks running in parallel are not
+ * serialized by the GIL and crashes of native extensions do not take down
+ * the main process.
+ *
+ * Workers are started on demand by executing the current application with
+ * the --py-worker argument (see PythonExecution::runPythonInterpreter) and
+ * communicate with the pool via a local socket. A worker serves one request
+ * per connection and terminates if the pool shuts down or after being idle
+ * for a while. The worker processes are owned by the pool, which kills them
+ * if they are broken, canceled or still busy when the pool shuts down.
+ *
+ * The pool is disabled by default, i.e. the worker count is zero.
+ */
+class GT_PYTHON_EXPORT GtpyWorkerPool
+{
+public:
+    /// Command line argument that starts the worker mode
+    static constexpr const char* WORKER_ARG = "--py-worker";
+
+    /// Command line argument that starts a resident script server
+    static constexpr const char* SERVER_ARG = "--py-server";
+
+    /**
+     * @brief Returns the instance of the worker pool.
+     * @return Worker pool instance
+     */
+    static GtpyWorkerPool* instance();
+
+    /**
+     * @brief Sets the maximum number of worker processes. Zero disables the
+     * worker pool.
+     * @param count Maximum number of worker processes.
+     */
+    void setWorkerCount(int count);
+
+    /**
+     * @brief Returns the maximum number of worker processes.
+     * @return Maximum number of worker processes.
+     */
+    int workerCount() const;
+
+    /**
+     * @brief Returns true if script evaluations should be dispatched to the
+     * worker processes.
+     * @return Whether the worker pool is enabled.
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Sets the program and the leading arguments used to start a
+     * worker. The worker arguments are appended to the given arguments.
+     * @param program Executable of the worker.
+     * @param args Leading arguments (e.g. the command line function name).
+     */
+    void setWorkerCommand(const QString& program,
+                          const QStringList& args = {});
+
+    /**
+     * @brief Evaluates the given request in an idle worker process. If all
+     * workers are busy and the worker count is reached, the call blocks until
+     * a worker becomes idle. The function is thread-safe.
+     * @param request Script evaluation request.
+     * @param canceled Optional function that is polled while waiting for the
+     * response. If it returns true, the worker is killed and the evaluation
+     * fails.
+     * @return Response of the worker. If the worker could not be reached,
+     * crashed or was canceled, GtpyWorkerResponse::error is set.
+     */
+    GtpyWorkerResponse run(const GtpyWorkerRequest& request,
+                           const std::function<bool()>& canceled = {});
+
+    /**
+     * @brief Asks all idle workers to terminate and kills the busy ones.
+     * Requests evaluated by busy workers fail.
+     */
+    void shutdown();
+
+    /**
+     * @brief Runs the worker loop. It is called in the worker process and
+     * returns when the worker terminates.
+     * @param serverName Name of the local server the worker listens on.
+     * @param resident If true, the worker does not terminate when being
+     * idle. It is used by script servers, which keep an initialized
+     * application ready for batch scripts (see SERVER_ARG).
+     * The server only accepts connections of the same user. Relative names
+     * are placed in the runtime directory of the user, except on Windows.
+     * @return Exit code of the worker process.
+     */
+    static int serve(const QString& serverName, bool resident = false);
+
+    /**
+     * @brief Sends the given request to the already running worker or
+     * script server listening on the given name and waits for the response.
+     * It does not require an initialized application, so that it can be used
+     * by thin clients.
+     * @param serverName Name of the local server of the worker.
+     * @param request Script evaluation request.
+     * @return Response of the worker. If the worker could not be reached or
+     * crashed, GtpyWorkerResponse::error is set.
+     */
+    static GtpyWorkerResponse request(const QString& serverName,
+                                      const GtpyWorkerRequest& request);
+
+private:
+    struct Worker
+    {
+        /// Name of the local server of the worker
+        QString serverName;
+
+        /// Whether the worker is currently evaluating a request
+        bool busy{false};
+    };
+
+    GtpyWorkerPool() = default;
+
+    /**
+     * @brief Takes an idle worker or starts a new one. Blocks if the worker
+     * count is reached.
+     * @return Name of the local server of the acquired worker. It is empty
+     * if no worker could be started.
+     */
+    QString acquireWorker();
+
+    /**
+     * @brief Starts the worker process listening on the given name. The
+     * process is owned by the process thread of the pool.
+     * @param serverName Name of the local server of the worker.
+     * @return True if the process was started.
+     */
+    bool startProcess(const QString& serverName);
+
+    /**
+     * @brief Kills the worker process listening on the given name. Does
+     * nothing if the process has already finished.
+     * @param serverName Name of the local server of the worker.
+     */
+    void killProcess(const QString& serverName);
+
+    /**
+     * @brief Marks the given worker as idle. If the worker is broken, it is
+     * killed and removed from the pool.
+     * @param serverName Name of the local server of the worker.
+     * @param broken True if the worker crashed or could not be reached.
+     */
+    void releaseWorker(const QString& serverName, bool broken);
+
+    /// Started workers
+    QList<Worker> m_workers;
+
+    /// Maximum number of workers
+    int m_workerCount{0};
+
+    /// Number of started workers
+    int m_serial{0};
+
+    QString m_program;
+
+    QStringList m_programArgs;
+
+    /// Thread running the event loop of the worker processes. QProcess
+    /// objects must be created and killed by the thread owning them, while
+    /// requests are run by arbitrary threads.
+    QThread* m_processThread{nullptr};
+
+    /// Parent of the QProcess objects, living in m_processThread
+    QObject* m_processOwner{nullptr};
+
+    /// Guards all members
+    mutable QMutex m_mutex;
+
+    /// Signaled whenever a worker becomes idle
+    QWaitCondition m_workerIdle;
+};
+
+#endif // GTPY_WORKERPOOL_H
@@ -8,10 +8,17 @@
  * Author: Marvin Noethen (DLR AT-TWK)
  */
 
+#include <QHash>
+#include <QMutex>
 #include <QThread>
+#include <QPointer>
 
 #include "PythonQtInstanceWrapper.h"
 
+#if PY_VERSION_HEX < 0x030B0000
+#include <frameobject.h>
+#endif
+
 #include "gt_application.h"
 #include "gt_calculator.h"
 #include "gt_calculatordata.h"
@@ -29,85 +36,135 @@
 
 using namespace GtpyCalculatorsModule;
 
-static GtTask*
-findValue__task()
+namespace
+{
+
+/**
+ * Tasks registered for the globals of Python contexts. The entries are
+ * accessed with the GIL held, but the mutex allows to remove them without it.
+ */
+struct ContextTasks
+{
+    QHash<const PyObject*, QPointer<GtTask>> tasks;
+
+    QMutex mutex;
+};
+
+// Intentionally leaked, since contexts may be deleted during shutdown
+ContextTasks&
+contextTasks()
 {
+    static auto* c = new ContextTasks;
+    return *c;
+}
+
+/**
+ * @brief Returns the task registered for the given globals. Entries of
+ * deleted tasks are removed, so that the globals are resolved as if no task
+ * was registered.
+ * @param globals Globals dict of a frame.
+ * @param found Set to true if a living task is registered for the globals.
+ * @return Registered task or nullptr if there is none.
+ */
+GtTask*
+registeredTask(const PyObject* globals, bool& found)
+{
+    auto& c = contextTasks();
+
+    QMutexLocker locker(&c.mutex);
+
+    auto iter = c.tasks.find(globals);
 
-    auto globals = PyPPEval_GetGlobals();
-    if (!globals || !PyPPDict_Check(globals)) return nullptr;
+    if (iter != c.tasks.end() && iter->isNull())
+    {
+        c.tasks.erase(iter);
+        iter = c.tasks.end();
+    }
 
-    auto taskVar = PyPPDict_GetItem(globals, gtpy::code::attrs::TASK);
+    found = iter != c.tasks.end();
+
+    return found ? iter->data() : nullptr;
+}
 
-    if(!taskVar) return nullptr;
+GtTask*
+taskFromPyObject(PyObject* taskVar)
+{
+    if (!taskVar) return nullptr;
 
     if (taskVar->ob_type->tp_base == &PythonQtInstanceWrapper_Type)
     {
-        PythonQtInstanceWrapper* wrapper =
-            (PythonQtInstanceWrapper*)taskVar.get();
+        PythonQtInstanceWrapper* wrapper = (PythonQtInstanceWrapper*)taskVar;
 
-        if (wrapper && wrapper->_obj)
+        if (wrapper->_obj)
         {
             return qobject_cast<GtTask*>(wrapper->_obj);
         }
-    }
-    else
-    {
-        GtObject* taskObj = GtpyDecorator::pyObjectToGtObject(
-            taskVar.get());
-        return qobject_cast<GtTask*>(taskObj);
+
+        return nullptr;
     }
 
-    return nullptr;
+    return qobject_cast<GtTask*>(GtpyDecorator::pyObjectToGtObject(taskVar));
 }
 
-static GtTask*
-findTaskFromHigherFrame()
+/**
+ * @brief Returns the task of the given globals. The task registered for the
+ * globals is preferred over the __task variable.
+ * @param globals Globals dict of a frame (borrowed reference).
+ * @return Task of the globals or nullptr.
+ */
+GtTask*
+taskOfGlobals(PyObject* globals)
 {
+    if (!globals || !PyDict_Check(globals)) return nullptr;
 
-    auto inspect = PyPPImport_ImportModule("inspect");
-
-    auto dict = PyPPModule_GetDict(inspect);
-    if (!dict) return nullptr;
-
+    bool found = false;
+    auto* task = registeredTask(globals, found);
+    if (found) return task;
 
-    auto func = PyPPDict_GetItem(dict, "currentframe");
-    if (!func || !PyPPCallable_Check(func)) return nullptr;
+    // interned once and intentionally leaked
+    static PyObject* key =
+        PyUnicode_InternFromString(gtpy::code::attrs::TASK);
+    if (!key) return nullptr;
 
+    // borrowed reference
+    return taskFromPyObject(PyDict_GetItem(globals, key));
+}
 
+GtTask*
+findTaskFromHigherFrame()
+{
     GtTask* parentTask = nullptr;
 
-    auto fram = PyPPObject_Call(func, PyPPTuple_New(0));
-    for (;fram; fram = PyPPObject_GetAttr(fram, "f_back"))
-    {
-        auto frameGlobals = PyPPObject_GetAttr(fram, "f_globals");
-        if (!frameGlobals || !PyPPDict_Check(frameGlobals)) continue;
+    // the outermost frame with a task wins, as the task of the context that
+    // runs the script is defined in the globals of its top level frame
+#if PY_VERSION_HEX >= 0x030B0000
+    using PyPPFrame = PyPPObjectT<PyFrameObject>;
 
-        auto taskVar = PyPPDict_GetItem(frameGlobals, gtpy::code::attrs::TASK);
-        if (!taskVar) continue;
+    for (auto frame = PyPPFrame::Borrow(PyEval_GetFrame()); frame;
+         frame = PyPPFrame::NewRef(PyFrame_GetBack(frame.get())))
+    {
+        auto globals = PyPPObject::NewRef(PyFrame_GetGlobals(frame.get()));
 
-        if (taskVar->ob_type->tp_base ==
-                &PythonQtInstanceWrapper_Type)
+        if (auto* task = taskOfGlobals(globals.get()))
         {
-            PythonQtInstanceWrapper* wrapper =
-                (PythonQtInstanceWrapper*)taskVar.get();
-
-            if (wrapper && wrapper->_obj)
-            {
-                parentTask = qobject_cast<GtTask*>(
-                                 wrapper->_obj);
-            }
+            parentTask = task;
         }
-        else
+    }
+#else
+    // borrowed references
+    for (auto* frame = PyEval_GetFrame(); frame; frame = frame->f_back)
+    {
+        if (auto* task = taskOfGlobals(frame->f_globals))
         {
-            GtObject* taskObj = GtpyDecorator::pyObjectToGtObject(taskVar.get());
-            parentTask = qobject_cast<GtTask*>(taskObj);
+            parentTask = task;
         }
     }
+#endif
 
     return parentTask;
 }
 
-static GtTask*
+GtTask*
 findTaskByRunnable()
 {
     auto thread = QThread::currentThread();
@@ -119,24 +176,31 @@ findTaskByRunnable()
                           {}, Qt::FindDirectChildrenOnly) : nullptr;
 }
 
-GtTask*
-GtpyCalculatorsModule::findRunningParentTask()
+} // namespace
+
+void
+GtpyCalculatorsModule::setContextTask(const PyObject* globals, GtTask* task)
 {
-    GtTask* parentTask = nullptr;
+    if (!globals) return;
 
-    parentTask = findValue__task();
+    auto& c = contextTasks();
 
-    if (!parentTask)
-    {
-        parentTask = findTaskFromHigherFrame();
-    }
+    QMutexLocker locker(&c.mutex);
 
-    if (!parentTask)
-    {
-        parentTask = findTaskByRunnable();
-    }
+    if (task) c.tasks.insert(globals, task);
+    else c.tasks.remove(globals);
+}
 
-    return parentTask;
+GtTask*
+GtpyCalculatorsModule::findRunningParentTask()
+{
+    // the globals of the running script are looked up first, which is the
+    // common case of calculators created in the script of a task
+    if (auto* task = taskOfGlobals(PyEval_GetGlobals())) return task;
+
+    if (auto* task = findTaskFromHigherFrame()) return task;
+
+    return findTaskByRunnable();
 }
 
 QString
@@ -33,9 +33,25 @@ typedef struct
 extern PyObject*
 findGtTask_C_function(PyObject* self, PyObject* args);
 
+/**
+ * @brief Returns the task of the running script. It is the task registered
+ * for the globals of the running script, the task stored in the __task
+ * variable of the running script or of a calling frame, or the task
+ * executed by the runnable of the current thread. Requires the GIL.
+ * @return Running parent task or nullptr.
+ */
 extern GtTask*
 findRunningParentTask();
 
+/**
+ * @brief Registers the task of the Python context with the given globals,
+ * which makes the lookup of the parent task of calculators independent of
+ * the depth of the call stack. Passing nullptr removes the registration.
+ * @param globals Globals dict of the context.
+ * @param task Task of the context.
+ */
+void setContextTask(const PyObject* globals, GtTask* task);
+
 static PyMethodDef
 GtpyCalculatorsModule_StaticMethods[] =
 {
@@ -9,6 +9,7 @@
  */
 
 #include "PythonQt.h"
+#include "PythonQtClassInfo.h"
 #include "PythonQtConversion.h"
 
 #include "gt_object.h"
@@ -20,8 +21,11 @@
 #include "gtpy_decorator.h"
 
 #include "gtpy_extendedwrapper.h"
+#include "gtpy_childindex.h"
 #include "gtpypp.h"
 
+#include <QSet>
+#include <QHash>
 #include <QRegularExpression>
 
 using namespace GtpyExtendedWrapperModule;
@@ -42,6 +46,255 @@ pointerAdress(QObject* obj)
     return retVal;
 }
 
+/**
+ * Per-object counterpart of the dispatch table. It keeps the properties
+ * found by GtObject::findProperty(), so that a hit does not search the
+ * properties of the object again, and the names that are no attribute of the
+ * object at all, so that misses do not rescan the properties.
+ */
+struct GtpyExtendedWrapperModule::GtpyPropertyCache
+{
+    /// Resolved properties by ident. QPointer drops deleted properties.
+    QHash<QString, QPointer<GtAbstractProperty>> props;
+
+    /// Attribute names that were neither resolved by PythonQt nor by the
+    /// dispatch table
+    QSet<QByteArray> misses;
+
+    /// Number of properties of the object including nested ones (see
+    /// GtObject::fullPropertyList()) when the misses were recorded. The
+    /// misses are dropped if properties are added or removed.
+    int propertyCount{-1};
+};
+
+namespace {
+
+/// Kind of an attribute resolved by the dispatch table
+enum class AttrKind
+{
+    Property,
+    Setter,
+    Helper
+};
+
+struct AttrEntry
+{
+    AttrKind kind;
+
+    /// Property ident or helper name
+    QString ident;
+};
+
+/**
+ * Maps Python attribute names of a class to its GtProperties, their setter
+ * methods and the create helper methods. The entries are shared by all
+ * objects of the class and extended by properties found on single objects.
+ * Since properties can differ per object, each hit is validated against the
+ * object with GtObject::findProperty().
+ */
+struct DispatchTable
+{
+    QHash<QByteArray, AttrEntry> attrs;
+
+    /// Whether a name is resolved by the PythonQt wrapper of the class
+    QHash<QByteArray, bool> shadowed;
+};
+
+/**
+ * @brief Returns the dispatch tables by class. The tables are guarded by the
+ * GIL. Intentionally leaked, like the other static Python related data.
+ * @return Dispatch tables by class.
+ */
+QHash<const QMetaObject*, DispatchTable>&
+dispatchTables()
+{
+    static auto* tables = new QHash<const QMetaObject*, DispatchTable>;
+    return *tables;
+}
+
+void
+addProperties(DispatchTable& table, GtObject* gtObj)
+{
+    const auto propList = gtObj->fullPropertyList();
+
+    for (auto* prop : propList)
+    {
+        QString propId{pyValidGtPropertyId(prop->ident())};
+
+        if (propId.isEmpty()) continue;
+
+        // Name of setter methods without string validation,
+        // in order to keep old scripts running
+        QString oldSetterName{prop->ident()};
+        oldSetterName.replace(0, 1, oldSetterName.at(0).toUpper());
+        oldSetterName.prepend("set");
+
+        QString setterName{propId};
+        setterName.replace(0, 1, oldSetterName.at(0).toUpper());
+        setterName.prepend("set");
+
+        // the first property wins, like in the former linear search
+        auto insert = [&](const QString& name, AttrKind kind){
+            auto key = name.toUtf8();
+            if (!table.attrs.contains(key))
+            {
+                table.attrs.insert(key, {kind, prop->ident()});
+            }
+        };
+
+        insert(propId, AttrKind::Property);
+        insert(setterName, AttrKind::Setter);
+        insert(oldSetterName, AttrKind::Setter);
+    }
+}
+
+DispatchTable&
+dispatchTable(GtObject* gtObj, PythonQtInstanceWrapper* wrapped)
+{
+    auto& tables = dispatchTables();
+
+    auto iter = tables.find(gtObj->metaObject());
+
+    if (iter != tables.end()) return iter.value();
+
+    DispatchTable table;
+
+    addProperties(table, gtObj);
+
+    const auto helperList = gtCalculatorHelperFactory->connectedHelper(
+        Py_TYPE(wrapped)->tp_name);
+
+    for (const auto& helperName : helperList)
+    {
+        auto key = QString{"create" + helperName}.toUtf8();
+        if (!table.attrs.contains(key))
+        {
+            table.attrs.insert(key, {AttrKind::Helper, helperName});
+        }
+    }
+
+    return tables.insert(gtObj->metaObject(), std::move(table)).value();
+}
+
+/**
+ * @brief Returns true if the given name is resolved by the PythonQt wrapper,
+ * which takes precedence over the GtProperties.
+ */
+bool
+isShadowed(DispatchTable& table, PythonQtInstanceWrapper* wrapped,
+           PyObject* name, const QByteArray& key)
+{
+    // dynamic Qt properties are resolved by PythonQt per object
+    if (wrapped->_obj->dynamicPropertyNames().contains(key)) return true;
+
+    auto iter = table.shadowed.constFind(key);
+    if (iter != table.shadowed.constEnd()) return iter.value();
+
+    auto* classInfo = PythonQt::priv()->getClassInfo(
+        wrapped->_obj->metaObject());
+
+    bool shadowed = _PyType_Lookup(Py_TYPE(wrapped), name) != nullptr ||
+            (classInfo && classInfo->member(key.constData())._type !=
+                 PythonQtMemberInfo::NotFound);
+
+    table.shadowed.insert(key, shadowed);
+
+    return shadowed;
+}
+
+GtpyPropertyCache&
+propertyCache(GtpyExtendedWrapper* wrapper)
+{
+    if (!wrapper->propertyCache)
+    {
+        wrapper->propertyCache = new GtpyPropertyCache;
+    }
+
+    return *wrapper->propertyCache;
+}
+
+/**
+ * @brief Returns the property with the given ident of the wrapped object.
+ * Found properties are kept in the property cache of the wrapper.
+ */
+GtAbstractProperty*
+cachedProperty(GtpyExtendedWrapper* wrapper, GtObject* gtObj,
+               const QString& ident)
+{
+    auto& cache = propertyCache(wrapper);
+
+    auto iter = cache.props.constFind(ident);
+    if (iter != cache.props.constEnd() && iter.value()) return iter.value();
+
+    auto* prop = gtObj->findProperty(ident);
+    if (prop) cache.props.insert(ident, prop);
+
+    return prop;
+}
+
+/**
+ * @brief Returns true if the given name is known to be no attribute of the
+ * wrapped object. Misses are forgotten once the number of properties of the
+ * object, including nested ones, changes.
+ */
+bool
+isKnownMiss(GtpyExtendedWrapper* wrapper, GtObject* gtObj,
+            const QByteArray& key)
+{
+    auto& cache = propertyCache(wrapper);
+
+    // the dispatch table resolves nested properties as well
+    const int count = gtObj->fullPropertyList().size();
+
+    if (cache.propertyCount != count)
+    {
+        cache.misses.clear();
+        cache.propertyCount = count;
+        return false;
+    }
+
+    return cache.misses.contains(key);
+}
+
+void
+addMiss(GtpyExtendedWrapper* wrapper, const QByteArray& key)
+{
+    propertyCache(wrapper).misses.insert(key);
+}
+
+/**
+ * @brief Returns the attribute of the given object resolved by the dispatch
+ * table. If the object lacks the property of the entry, nullptr is returned.
+ */
+PyObject*
+dispatchedAttr(const AttrEntry& entry, GtObject* gtObj, PyObject* self)
+{
+    if (entry.kind == AttrKind::Helper)
+    {
+        auto childArg = PyPPTuple_New(2);
+
+        PyPPTuple_SetItem(childArg, 0, PyPPObject::fromQString(entry.ident));
+        PyPPTuple_SetItem(childArg, 1, PyPPObject::Borrow(self));
+
+        return PyObject_CallObject((PyObject*) &GtpyCreateHelperFunction_Type,
+                                   childArg.get());
+    }
+
+    auto* prop = cachedProperty(reinterpret_cast<GtpyExtendedWrapper*>(self),
+                                gtObj, entry.ident);
+
+    if (!prop) return nullptr;
+
+    if (entry.kind == AttrKind::Property)
+    {
+        return PyPPObject::fromQVariant(prop->valueToVariant()).release();
+    }
+
+    return GtpyPropertySetter_New(entry.ident, self, nullptr);
+}
+
+} // namespace
+
 static ternaryfunc pythonqt_slot_call = nullptr;
 
 PyObjectAPIReturn
@@ -75,9 +328,82 @@ GtpyCustomization::customizeSlotCalling()
     PythonQtSlotFunction_Type.tp_call = PythonQtSlotFunction_MyCall;
 }
 
+namespace
+{
+
+/// Live wrappers by wrapped object. The wrappers are not owned by the
+/// cache, each wrapper removes itself on deallocation. The cache is only
+/// accessed with the GIL held.
+QHash<const QObject*, GtpyExtendedWrapper*>&
+wrapperCache()
+{
+    // Intentionally leaked, since wrappers may be deallocated at shutdown
+    static auto* cache = new QHash<const QObject*, GtpyExtendedWrapper*>;
+    return *cache;
+}
+
+} // namespace
+
+PyObject*
+GtpyExtendedWrapperModule::cachedWrapper(const QObject* obj)
+{
+    auto& cache = wrapperCache();
+
+    auto iter = cache.find(obj);
+    if (iter == cache.end()) return nullptr;
+
+    GtpyExtendedWrapper* wrapper = iter.value();
+
+    // the object has been destroyed, its address may be reused
+    if (wrapper->getObject() != obj)
+    {
+        wrapper->cacheKey = nullptr;
+        cache.erase(iter);
+        return nullptr;
+    }
+
+    Py_INCREF(wrapper);
+    return (PyObject*)wrapper;
+}
+
+void
+GtpyExtendedWrapperModule::setCachedWrapper(GtpyExtendedWrapper* wrapper)
+{
+    const QObject* obj = wrapper->getObject();
+
+    if (!obj || wrapper->forcePythonOwnership) return;
+
+    removeCachedWrapper(obj);
+
+    wrapperCache().insert(obj, wrapper);
+    wrapper->cacheKey = obj;
+}
+
+void
+GtpyExtendedWrapperModule::removeCachedWrapper(const QObject* obj)
+{
+    if (GtpyExtendedWrapper* wrapper = wrapperCache().take(obj))
+    {
+        wrapper->cacheKey = nullptr;
+    }
+}
+
 static void
 GtpyExtendedWrapper_dealloc(GtpyExtendedWrapper* self)
 {
+    if (self->cacheKey)
+    {
+        auto& cache = wrapperCache();
+
+        auto iter = cache.find(self->cacheKey);
+        if (iter != cache.end() && iter.value() == self) cache.erase(iter);
+
+        self->cacheKey = nullptr;
+    }
+
+    delete self->propertyCache;
+    self->propertyCache = nullptr;
+
     if (self->_obj)
     {
         if (self->forcePythonOwnership && self->_obj->_obj)
@@ -280,44 +606,53 @@ GtpyExtendedWrapper_setattro(PyObject* obj, PyObject* name, PyObject* value)
     if (gtObj)
     {
         ///Set GtProperty
-        QList<GtAbstractProperty*> propList = gtObj->fullPropertyList();
+        QByteArray key{PyUnicode_AsUTF8(name)};
+        auto& table = dispatchTable(gtObj, wrapper->_obj);
 
-        foreach (GtAbstractProperty* prop, propList)
+        auto findProp = [&]() -> GtAbstractProperty* {
+            auto iter = table.attrs.constFind(key);
+            if (iter == table.attrs.constEnd() ||
+                iter->kind != AttrKind::Property) return nullptr;
+
+            return cachedProperty(wrapper, gtObj, iter->ident);
+        };
+
+        auto* prop = findProp();
+
+        if (!prop && !isKnownMiss(wrapper, gtObj, key))
         {
-            QString pyName = pyValidGtPropertyId(prop->ident());
+            // the object may have properties unknown to its class table
+            addProperties(table, gtObj);
+            prop = findProp();
 
-            if (pyName == strName)
+            if (!prop) addMiss(wrapper, key);
+        }
+
+        if (prop)
+        {
+            if (PyObject_TypeCheck(value, &GtpyExtendedWrapper_Type))
             {
-                if (PyObject_TypeCheck(value, &GtpyExtendedWrapper_Type))
-                {
-                    value = (PyObject*)reinterpret_cast<GtpyExtendedWrapper*>(value)->_obj;
-                }
+                value = (PyObject*)reinterpret_cast<GtpyExtendedWrapper*>(value)->_obj;
+            }
 
-                GtpyDecorator decorator;
-                decorator.setPropertyValue(
-                    gtObj, prop->ident(),
-                    PythonQtConv::PyObjToQVariant(value));
+            GtpyDecorator decorator;
+            decorator.setPropertyValue(
+                gtObj, prop->ident(),
+                PythonQtConv::PyObjToQVariant(value));
 
-                return 0;
-            }
+            return 0;
         }
     }
 
     ///Set child error
-    QObjectList children = wrapper->_obj->_obj->children();
-
-    for (int i = 0; i < children.count(); i++)
+    if (QObject* child = gtpy::childindex::findChild<QObject*>(
+            wrapper->_obj->_obj, strName))
     {
-        QObject* child = children.at(i);
+        error = "It is not allowed to overwrite the child element " +
+                child->objectName() + " (" + pointerAdress(child) + ")";
 
-        if (child->objectName() == strName)
-        {
-            error = "It is not allowed to overwrite the child element " +
-                    child->objectName() + " (" + pointerAdress(child) + ")";
-
-            PyErr_SetString(PyExc_ValueError, error.toLatin1().data());
-            return -1;
-        }
+        PyErr_SetString(PyExc_ValueError, error.toLatin1().data());
+        return -1;
     }
 
     return PythonQtInstanceWrapper_Type.tp_setattro((PyObject*)wrapper->_obj,
@@ -416,20 +751,51 @@ GtpyExtendedWrapper_getattro(PyObject* obj, PyObject* name)
     }
 
     // If the attribute is a child object, it will be wrapped and returned
-    auto children = wrapper->_obj->_obj->children();
+    auto children = gtpy::childindex::findChildren(wrapper->_obj->_obj, strName);
     for (auto* child : qAsConst(children))
     {
-        if (child->objectName() == strName)
+        if (PyObject* cached = cachedWrapper(child))
         {
-            auto pyQtWrapper = PyPPObject::NewRef(PythonQt::priv()->wrapQObject(child));
+            return cached;
+        }
+
+        auto pyQtWrapper = PyPPObject::NewRef(PythonQt::priv()->wrapQObject(child));
 
-            if (pyQtWrapper)
+        if (pyQtWrapper)
+        {
+            auto childArg = PyPPTuple_New(1);
+            PyPPTuple_SetItem(childArg, 0, std::move(pyQtWrapper));
+
+            // Create a new GtpyExtendedWrapper object
+            PyObject* childWrapper = PyObject_CallObject(
+                (PyObject*) &GtpyExtendedWrapper_Type, childArg.get());
+
+            if (childWrapper && PyObject_TypeCheck(childWrapper,
+                                                   &GtpyExtendedWrapper_Type))
             {
-                auto childArg = PyPPTuple_New(1);
-                PyPPTuple_SetItem(childArg, 0, std::move(pyQtWrapper));
+                setCachedWrapper((GtpyExtendedWrapper*)childWrapper);
+            }
 
-                // Create a new GtpyExtendedWrapper object
-                return PyObject_CallObject((PyObject*) &GtpyExtendedWrapper_Type, childArg.get());
+            return childWrapper;
+        }
+    }
+
+    GtObject* gtObj = qobject_cast<GtObject*>(qObj);
+    QByteArray key{strName.toUtf8()};
+
+    // Fast path: GtProperties, setters and create helper methods known to
+    // the dispatch table, if they are not shadowed by the PythonQt wrapper
+    if (gtObj)
+    {
+        auto& table = dispatchTable(gtObj, wrapper->_obj);
+        auto iter = table.attrs.constFind(key);
+
+        if (iter != table.attrs.constEnd() &&
+            !isShadowed(table, wrapper->_obj, name, key))
+        {
+            if (auto* attr = dispatchedAttr(iter.value(), gtObj, obj))
+            {
+                return attr;
             }
         }
     }
@@ -444,61 +810,35 @@ GtpyExtendedWrapper_getattro(PyObject* obj, PyObject* name)
         return pyQtWrapperAttr;
     }
 
-    // Get GtProperties values or setter methods
-    if (GtObject* gtObj = qobject_cast<GtObject*>(qObj))
+    // Get GtProperties values, setter or create helper methods of properties
+    // the object has in addition to the other objects of its class
+    if (gtObj && !isKnownMiss(wrapper, gtObj, key))
     {
-        auto propList = gtObj->fullPropertyList();
-        for (auto* prop : qAsConst(propList))
-        {
-            QString propId{pyValidGtPropertyId(prop->ident())};
+        auto& table = dispatchTable(gtObj, wrapper->_obj);
+        addProperties(table, gtObj);
 
-            if (!propId.isEmpty())
-            {
-                if (propId == strName)
-                {
-                    return PyPPObject::fromQVariant(prop->valueToVariant()).release();
-                }
+        auto iter = table.attrs.constFind(key);
 
-                if (strName.startsWith("set"))
-                {
-                    // Name of setter methods without string validation,
-                    // in order to keep old scripts running
-                    QString oldSetterName{prop->ident()};
-                    oldSetterName.replace(0, 1, oldSetterName.at(0).toUpper());
-                    oldSetterName.prepend("set");
-
-                    propId.replace(0, 1, oldSetterName.at(0).toUpper());
-                    propId.prepend("set");
-
-                    if (propId == strName || oldSetterName == strName)
-                    {
-                        return GtpyPropertySetter_New(prop->ident(), obj,
-                                                      nullptr);
-                    }
-                }
+        if (iter != table.attrs.constEnd())
+        {
+            if (auto* attr = dispatchedAttr(iter.value(), gtObj, obj))
+            {
+                return attr;
             }
         }
-    }
 
-    // Get create helper methods
-    QStringList helperList = gtCalculatorHelperFactory->connectedHelper(
-                                 Py_TYPE(wrapper->_obj)->tp_name);
-
-    for (const auto& helperName : qAsConst(helperList))
+        addMiss(wrapper, key);
+    }
+    else
     {
-        QString createHelperName{"create" + helperName};
+        // Get create helper methods of other QObjects
+        QStringList helperList = gtCalculatorHelperFactory->connectedHelper(
+                                     Py_TYPE(wrapper->_obj)->tp_name);
 
-        if (strName == createHelperName)
+        if (helperList.contains(strName.mid(6)) && strName.startsWith("create"))
         {
-            auto childArg = PyPPTuple_New(2);
-
-            PyPPTuple_SetItem(childArg, 0, PyPPObject::fromQString(helperName));
-            PyPPTuple_SetItem(childArg, 1, PyPPObject::Borrow(obj));
-
-//          return GtpyCreateHelperFunction_Type.tp_new(
-//                                   &GtpyCreateHelperFunction_Type, childArg,
-//                                   nullptr);
-            return PyObject_CallObject((PyObject*) &GtpyCreateHelperFunction_Type, childArg.get());
+            return dispatchedAttr({AttrKind::Helper, strName.mid(6)},
+                                  nullptr, obj);
         }
     }
 
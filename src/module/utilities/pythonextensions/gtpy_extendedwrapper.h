@@ -23,6 +23,8 @@ namespace GtpyExtendedWrapperModule
 {
 extern PyTypeObject GtpyExtendedWrapper_Type;
 
+struct GtpyPropertyCache;
+
 /// Python wrapper the the GTObject
 struct GtpyExtendedWrapper
 {
@@ -34,9 +36,41 @@ struct GtpyExtendedWrapper
     /// the object is part of a c++ tree
     bool forcePythonOwnership = {false};
 
+    /// Object under which the wrapper is registered in the wrapper cache
+    const QObject* cacheKey = {nullptr};
+
+    /// Properties and unknown attribute names resolved for the wrapped
+    /// object. Created on the first attribute access.
+    GtpyPropertyCache* propertyCache = {nullptr};
+
     QObject* getObject() const;
 };
 
+/**
+ * @brief Returns the live wrapper registered for the given object by
+ * setCachedWrapper(). Wrappers of destroyed objects are discarded, even if
+ * a new object has been created at the same address. The GIL must be held.
+ * @param obj Wrapped object.
+ * @return New reference to the cached wrapper or nullptr.
+ */
+PyObject* cachedWrapper(const QObject* obj);
+
+/**
+ * @brief Registers the wrapper for its object, so that navigating to the
+ * object again returns the same wrapper. The cache does not keep the
+ * wrapper alive. Wrappers forcing Python ownership are not cached. The GIL
+ * must be held.
+ * @param wrapper Wrapper to register.
+ */
+void setCachedWrapper(GtpyExtendedWrapper* wrapper);
+
+/**
+ * @brief Removes the wrapper registered for the given object from the
+ * cache. The GIL must be held.
+ * @param obj Wrapped object.
+ */
+void removeCachedWrapper(const QObject* obj);
+
 static PyModuleDef
 GtpyExtendedWrapper_Module =
 {
@@ -8,11 +8,12 @@
  * Author: Marvin Noethen (DLR AT-TWK)
  */
 
+#include <atomic>
+
 #include "gt_logging.h"
 
 #include "gtpy_loggingmodule.h"
-
-#include "gt_logging.h"
+#include "gtpy_stdout.h"
 
 #include "gtpypp.h"
 
@@ -21,17 +22,80 @@ using namespace GtpyLoggingModule;
 namespace
 {
 
+/// Minimum level of the messages that are logged by contexts that did not
+/// set their own level
+std::atomic<int> s_level{DEBUG};
+
+/**
+ * @brief Returns the severity of the given level. The values of LogLevel are
+ * not ordered by severity.
+ */
+int severity(LogLevel level)
+{
+    switch (level)
+    {
+    case DEBUG:   return 0;
+    case INFO:    return 1;
+    case WARNING: return 2;
+    case ERROR:   return 3;
+    case FATAL:   return 4;
+    default:      return 0;
+    }
+}
+
 bool isLoggingToAppConsolEnabled()
 {
-    auto globals = PyPPEval_GetGlobals();
-    if (!globals || !PyPPDict_Check(globals)) return false;
+    // interned once and intentionally leaked, dict lookups with it use the
+    // cached hash
+    static PyObject* key =
+        PyUnicode_InternFromString(gtpy::code::attrs::LOGGING_ENABLED);
+
+    // borrowed references, no objects are created per call
+    auto* globals = PyEval_GetGlobals();
+    if (!globals || !PyDict_Check(globals) || !key) return false;
+
+    return PyDict_GetItem(globals, key) == Py_True;
+}
+
+/**
+ * @brief Returns the log level set by the context of the calling code, i.e.
+ * the level stored in its globals, or -1 if there is none.
+ */
+int contextLevel()
+{
+    // interned once and intentionally leaked, see isLoggingToAppConsolEnabled
+    static PyObject* key =
+        PyUnicode_InternFromString(gtpy::code::attrs::LOG_LEVEL);
 
-    auto loggingEnabledObj = PyPPDict_GetItem(
-        globals, gtpy::code::attrs::LOGGING_ENABLED);
+    // borrowed references
+    auto* globals = PyEval_GetGlobals();
+    if (!globals || !PyDict_Check(globals) || !key) return -1;
 
-    if (!loggingEnabledObj || !PyPPBool_Check(loggingEnabledObj)) return false;
+    auto* level = PyDict_GetItem(globals, key);
+    if (!level || !PyLong_Check(level)) return -1;
 
-    return loggingEnabledObj.get() == Py_True;
+    return static_cast<int>(PyLong_AsLong(level));
+}
+
+void writeToPyConsol(PyObject* out, const QString& text)
+{
+    // pass the text to the redirection of GTlab directly
+    if (Py_TYPE(out) == &GtpyStdOutRedirect_Type)
+    {
+        auto* redirect = reinterpret_cast<GtpyStdOutRedirect*>(out);
+        if (redirect->callback) (*redirect->callback)(text);
+        return;
+    }
+
+    // sys.stdout was replaced by the script, e.g. to capture the output
+    static PyObject* write = PyUnicode_InternFromString("write");
+    if (!write) return;
+
+    auto pyStr = PyPPObject::fromQString(text);
+    auto result = PyPPObject::NewRef(
+        PyObject_CallMethodObjArgs(out, write, pyStr.get(), nullptr));
+
+    if (!result) PyErr_Clear();
 }
 
 void printToPyConsol(LogLevel type, const QString& msg)
@@ -44,22 +108,14 @@ void printToPyConsol(LogLevel type, const QString& msg)
         { WARNING, "[WARNING] " }
     };
 
-    QString pyMsg{msg};
-    if (prefixes.contains(type)) pyMsg.prepend(prefixes[type]);
-
-    auto globals = PyPPEval_GetGlobals();
-    if (!globals || !PyPPDict_Check(globals)) return;
+    // borrowed reference
+    auto* out = PySys_GetObject("stdout");
+    if (!out) return;
 
-    auto builtinsDict = PyPPDict_GetItem(globals, "__builtins__");
-    if (!builtinsDict || !PyPPDict_Check(builtinsDict)) return;
-
-    auto print = PyPPDict_GetItem(builtinsDict, "print");
-    if (!print || !PyPPCallable_Check(print)) return;
-
-    auto argsTuple = PyPPTuple_New(1);
-    PyPPTuple_SetItem(argsTuple, 0, PyPPObject::fromQString(pyMsg));
-
-    PyPPObject_Call(print, argsTuple);
+    // the message and the line break are written separately like print()
+    // does, which the batch output relies on
+    writeToPyConsol(out, prefixes.value(type) + msg);
+    writeToPyConsol(out, QStringLiteral("\n"));
 }
 
 void printToAppConsol(LogLevel type, const QString& msg)
@@ -111,36 +167,90 @@ createLogger(LogLevel outputType)
     return logger.release();
 }
 
+/**
+ * @brief Converts the argument to a string (equivalent to calling str(arg))
+ * and logs it.
+ * @return False if the conversion raised an exception.
+ */
+bool
+logObject(LogLevel level, PyObject* arg)
+{
+    auto pyMsg = PyPPObject_Str(PyPPObject::Borrow(arg));
+    if (!pyMsg) return false;
+
+    Py_ssize_t size = 0;
+    const auto* msg = PyUnicode_AsUTF8AndSize(pyMsg.get(), &size);
+    if (!msg) return false;
+
+    printToConsols(level, QString::fromUtf8(msg, static_cast<int>(size)));
+
+    return true;
+}
+
 PyObjectAPIReturn
 printLogMsg(LogLevel level, PyObject* args)
 {
-    if (!args) Py_RETURN_NONE;
+    if (!args || !PyTuple_Check(args)) Py_RETURN_NONE;
 
-    PyObject* pyArg = nullptr;
-
-    // check if no argument or one argument is passed
-    if (!PyArg_ParseTuple(args, "|O", &pyArg)) return nullptr;
+    const auto argsCount = PyTuple_GET_SIZE(args);
 
     // if no argument is passed, return a logger instance to support
     // the use of the lshift "<<" operator for logging
-    if (!pyArg) return createLogger(level);
+    if (argsCount == 0) return createLogger(level);
+
+    // messages below the threshold are neither converted nor formatted
+    if (!isEnabled(level)) Py_RETURN_NONE;
 
-    auto arg = PyPPObject::Borrow(pyArg);
+    auto* pyArg = PyTuple_GET_ITEM(args, 0);
 
-    // convert the argument to a Python unicode object
-    // (equivalent to calling str(arg))
-    auto pyMsg = PyPPObject_Str(arg);
-    if (!pyMsg) return nullptr;
+    if (argsCount == 1)
+    {
+        if (!logObject(level, pyArg)) return nullptr;
+        Py_RETURN_NONE;
+    }
 
-    // convert the Python unicode object to a char pointer
-    const auto* msg = PyPPUnicode_AsUTF8(pyMsg);
-    if (!msg) return nullptr;
+    // gtDebug(format, *values) is formatted like format % values
+    if (!PyUnicode_Check(pyArg))
+    {
+        PyErr_SetString(PyExc_TypeError,
+                        "the format of a log message must be a str");
+        return nullptr;
+    }
 
-    printToConsols(level, msg);
+    auto values = PyPPObject::NewRef(PyTuple_GetSlice(args, 1, argsCount));
+    if (!values) return nullptr;
+
+    auto formatted = PyPPObject::NewRef(PyUnicode_Format(pyArg,
+                                                         values.get()));
+    if (!formatted) return nullptr;
+
+    if (!logObject(level, formatted.get())) return nullptr;
 
     Py_RETURN_NONE;
 }
 
+} // namespace
+
+void
+GtpyLoggingModule::setLogLevel(LogLevel level)
+{
+    s_level = level;
+}
+
+LogLevel
+GtpyLoggingModule::logLevel()
+{
+    return static_cast<LogLevel>(s_level.load());
+}
+
+bool
+GtpyLoggingModule::isEnabled(LogLevel level)
+{
+    const int ctxLevel = contextLevel();
+
+    return severity(level) >= severity(ctxLevel >= 0 ?
+                                           static_cast<LogLevel>(ctxLevel) :
+                                           logLevel());
 }
 
 static void
@@ -247,26 +357,71 @@ GtpyLoggingModule::gtWarning_C_function(PyObject* /*self*/, PyObject* args)
     return printLogMsg(WARNING, args);
 }
 
+PyObjectAPIReturn
+GtpyLoggingModule::setLogLevel_C_function(PyObject* /*self*/, PyObject* args)
+{
+    int level = DEBUG;
+    if (!PyArg_ParseTuple(args, "i", &level)) return nullptr;
+
+    if (level < DEBUG || level > WARNING)
+    {
+        PyErr_SetString(PyExc_ValueError, "invalid log level");
+        return nullptr;
+    }
+
+    // the level applies to the calling context only
+    auto* globals = PyEval_GetGlobals();
+
+    if (!globals)
+    {
+        setLogLevel(static_cast<LogLevel>(level));
+        Py_RETURN_NONE;
+    }
+
+    auto value = PyPPObject::fromLong(level);
+
+    if (PyDict_SetItemString(globals, gtpy::code::attrs::LOG_LEVEL,
+                             value.get()) != 0)
+    {
+        return nullptr;
+    }
+
+    Py_RETURN_NONE;
+}
+
+PyObjectAPIReturn
+GtpyLoggingModule::logLevel_C_function(PyObject* /*self*/, PyObject* /*args*/)
+{
+    const int ctxLevel = contextLevel();
+
+    return PyLong_FromLong(ctxLevel >= 0 ? ctxLevel : logLevel());
+}
+
+void
+GtpyLoggingModule::addLogLevels(PyObject* module)
+{
+    if (!module) return;
+
+    PyModule_AddIntConstant(module, "DEBUG", DEBUG);
+    PyModule_AddIntConstant(module, "INFO", INFO);
+    PyModule_AddIntConstant(module, "WARNING", WARNING);
+    PyModule_AddIntConstant(module, "ERROR", ERROR);
+    PyModule_AddIntConstant(module, "FATAL", FATAL);
+}
+
 static PyObjectAPIReturn
 GtpyPyLogger_lshift(PyObject* self, PyObject* arg)
 {
     if (!self || !arg) Py_RETURN_NONE;
 
     auto* logger = (GtpyPyLogger*)self;
-    auto pyppArg = PyPPObject::Borrow(arg);
-
-    // convert the argument to a Python unicode object
-    // (equivalent to calling str(arg))
-    auto pyMsg = PyPPObject_Str(pyppArg);
-    if (!pyMsg) return nullptr;
-
-    // convert the Python unicode object to a char pointer
-    const auto* msg = PyPPUnicode_AsUTF8(pyMsg);
-    if (!msg) return nullptr;
 
     auto logLevel = static_cast<LogLevel>(PyLong_AsLong(logger->m_logLevel));
 
-    printToConsols(logLevel, msg);
+    // messages below the threshold are not converted
+    if (!isEnabled(logLevel)) Py_RETURN_NONE;
+
+    if (!logObject(logLevel, arg)) return nullptr;
 
     Py_RETURN_NONE;
 }
@@ -17,6 +17,7 @@
 
 #include "gtpy_globals.h"
 #include "gtpy_code.h"
+#include "gt_pythonmodule_exports.h"
 
 namespace GtpyLoggingModule
 {
@@ -30,6 +31,36 @@ enum LogLevel
     WARNING
 };
 
+/**
+ * @brief Sets the minimum level of the messages logged from Python. Messages
+ * below this level are discarded before they are converted to a string.
+ * The order of the levels is DEBUG < INFO < WARNING < ERROR < FATAL.
+ * Contexts that called setLogLevel() from Python use their own level
+ * instead, which is stored in their globals and dropped on reset.
+ * @param level Minimum log level.
+ */
+GT_PYTHON_EXPORT void setLogLevel(LogLevel level);
+
+/**
+ * @brief Returns the minimum level of the messages logged from Python.
+ * @return Minimum log level.
+ */
+GT_PYTHON_EXPORT LogLevel logLevel();
+
+/**
+ * @brief Returns whether messages of the given level are logged by the
+ * calling Python code, considering the level of its context.
+ * @param level Log level.
+ * @return True if messages of the given level are logged.
+ */
+GT_PYTHON_EXPORT bool isEnabled(LogLevel level);
+
+/**
+ * @brief Adds the log levels as integer constants to the given module.
+ * @param module GtLogging module.
+ */
+void addLogLevels(PyObject* module);
+
 extern PyTypeObject GtpyPyLogger_Type;
 
 typedef struct
@@ -53,14 +84,22 @@ gtFatal_C_function(PyObject* self, PyObject* args);
 extern PyObjectAPIReturn
 gtWarning_C_function(PyObject* self, PyObject* args);
 
+extern PyObjectAPIReturn
+setLogLevel_C_function(PyObject* self, PyObject* args);
+
+extern PyObjectAPIReturn
+logLevel_C_function(PyObject* self, PyObject* args);
+
 static PyMethodDef
 GtpyLoggingModule_StaticMethods[] =
 {
     {
         gtpy::code::funcs::GT_DEBUG, (PyCFunction)gtDebug_C_function,
         METH_VARARGS,
-        "gtDebug([message]) -> None | GtpyPyLogger\n"
+        "gtDebug([message[, *args]]) -> None | GtpyPyLogger\n"
         "Logs a debug-level message if a message is provided.\n"
+        "Additional arguments are applied to the message using the % "
+        "operator, but only if the message is not filtered by the log level.\n"
         "Otherwise returns a GtpyPyLogger instance that allows logging using "
         "the lshift operator (e.g. gtDebug() << 'debug message').\n"
         "The recommended usage is: gtDebug('debug message')."
@@ -68,8 +107,10 @@ GtpyLoggingModule_StaticMethods[] =
     {
         gtpy::code::funcs::GT_INFO, (PyCFunction)gtInfo_C_function,
         METH_VARARGS,
-        "gtInfo([message]) -> None | GtpyPyLogger\n"
+        "gtInfo([message[, *args]]) -> None | GtpyPyLogger\n"
         "Logs an info-level message if a message is provided.\n"
+        "Additional arguments are applied to the message using the % "
+        "operator, but only if the message is not filtered by the log level.\n"
         "Otherwise returns a GtpyPyLogger instance that allows logging using "
         "the lshift operator (e.g. gtInfo() << 'info message').\n"
         "The recommended usage is: gtInfo('info message')."
@@ -77,8 +118,10 @@ GtpyLoggingModule_StaticMethods[] =
     {
         gtpy::code::funcs::GT_ERROR, (PyCFunction)gtError_C_function,
         METH_VARARGS,
-        "gtError([message]) -> None | GtpyPyLogger\n"
+        "gtError([message[, *args]]) -> None | GtpyPyLogger\n"
         "Logs an error-level message if a message is provided.\n"
+        "Additional arguments are applied to the message using the % "
+        "operator, but only if the message is not filtered by the log level.\n"
         "Otherwise returns a GtpyPyLogger instance that allows logging using "
         "the lshift operator (e.g. gtError() << 'error message').\n"
         "The recommended usage is: gtError('error message')."
@@ -86,8 +129,10 @@ GtpyLoggingModule_StaticMethods[] =
     {
         gtpy::code::funcs::GT_FATAL, (PyCFunction)gtFatal_C_function,
         METH_VARARGS,
-        "gtFatal([message]) -> None | GtpyPyLogger\n"
+        "gtFatal([message[, *args]]) -> None | GtpyPyLogger\n"
         "Logs a fatal-level message if a message is provided.\n"
+        "Additional arguments are applied to the message using the % "
+        "operator, but only if the message is not filtered by the log level.\n"
         "Otherwise returns a GtpyPyLogger instance that allows logging using "
         "the lshift operator (e.g. gtFatal() << 'fatal message').\n"
         "The recommended usage is: gtFatal('fatal message')."
@@ -95,12 +140,27 @@ GtpyLoggingModule_StaticMethods[] =
     {
         gtpy::code::funcs::GT_WARNING, (PyCFunction)gtWarning_C_function,
         METH_VARARGS,
-        "gtWarning([message]) -> None | GtpyPyLogger\n"
+        "gtWarning([message[, *args]]) -> None | GtpyPyLogger\n"
         "Logs a warning-level message if a message is provided.\n"
+        "Additional arguments are applied to the message using the % "
+        "operator, but only if the message is not filtered by the log level.\n"
         "Otherwise returns a GtpyPyLogger instance that allows logging using "
         "the lshift operator (e.g. gtWarning() << 'warning message').\n"
         "The recommended usage is: gtWarning('warning message')."
     },
+    {
+        gtpy::code::funcs::SET_LOG_LEVEL, (PyCFunction)setLogLevel_C_function,
+        METH_VARARGS,
+        "setLogLevel(level) -> None\n"
+        "Sets the minimum level of the messages logged by the current "
+        "context, e.g. setLogLevel(WARNING) discards debug and info messages."
+    },
+    {
+        gtpy::code::funcs::LOG_LEVEL, (PyCFunction)logLevel_C_function,
+        METH_NOARGS,
+        "logLevel() -> int\n"
+        "Returns the minimum level of the logged messages."
+    },
     { NULL, NULL, 0, NULL }
 };
 
@@ -28,6 +28,7 @@ GtpyStdOutRedirect_new(PyTypeObject* type, PyObject* /*args*/,
     self->softspace = 0;
     self->closed = false;
     self->callback = NULL;
+    self->flushCallback = NULL;
 
     return (PyObject*)self;
 }
@@ -37,40 +38,6 @@ GtpyStdOutRedirect_write(PyObject* self, PyObject* args)
 {
     GTPY_GIL_SCOPE
 
-    auto threadDict = PyPPThreadState_GetDict();
-
-    if (!threadDict)
-    {
-        return Py_BuildValue("");
-    }
-
-
-    auto valItem = PyPPDict_GetItem(threadDict, gtpy::code::keys::CONTEXT);
-    QString contextName;
-
-    if (valItem && PyPPUnicode_Check(valItem))
-    {
-        contextName = PyPPString_AsQString(valItem);
-    }
-
-    auto outputItem = PyPPDict_GetItem(threadDict, gtpy::code::keys::OUTPUT);
-
-    bool output = false;
-
-    if (outputItem && PyPPLong_Check(outputItem))
-    {
-        output = (bool)PyPPLong_AsLong(outputItem);
-    }
-
-    auto errorItem = PyPPDict_GetItem(threadDict, gtpy::code::keys::ERROR);
-
-    bool error = false;
-
-    if (errorItem && PyPPLong_Check(errorItem))
-    {
-        error = (bool)PyPPLong_AsLong(errorItem);
-    }
-
     GtpyStdOutRedirect* s = (GtpyStdOutRedirect*)self;
 
     if (s->callback)
@@ -101,11 +68,11 @@ GtpyStdOutRedirect_write(PyObject* self, PyObject* args)
 
         if (s->softspace > 0)
         {
-            (*s->callback)(contextName, output, error, QString(""));
+            (*s->callback)(QString(""));
             s->softspace = 0;
         }
 
-        (*s->callback)(contextName, output, error, message);
+        (*s->callback)(message);
     }
 
 
@@ -113,8 +80,15 @@ GtpyStdOutRedirect_write(PyObject* self, PyObject* args)
 }
 
 static PyObjectAPIReturn
-GtpyStdOutRedirect_flush(PyObject* /*self*/, PyObject* /*args*/)
+GtpyStdOutRedirect_flush(PyObject* self, PyObject* /*args*/)
 {
+    GtpyStdOutRedirect* s = (GtpyStdOutRedirect*)self;
+
+    if (s->flushCallback)
+    {
+        (*s->flushCallback)();
+    }
+
     return Py_BuildValue("");
 }
 
@@ -152,8 +126,7 @@ GtpyStdOutRedirect_methods[] =
     },
     {
         "flush", (PyCFunction)GtpyStdOutRedirect_flush, METH_VARARGS,
-        "flush the output, currently not implemented but needed for logging "
-        "framework"
+        "flush the pending output of the calling thread"
     },
     {
         "isatty", (PyCFunction)GtpyStdOutRedirect_isatty,   METH_NOARGS,
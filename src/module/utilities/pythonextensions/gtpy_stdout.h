@@ -24,15 +24,17 @@ extern PyTypeObject GtpyStdOutRedirect_Type;
 
 /**
  * @brief Declares the callback that is called from the write() function in
- * Python.
- * @param contextName Name of the context in which the message was triggered.
- * @param output Determines whether the output should be shared or not.
- * @param error Determines whether the error message should be displayed or not.
+ * Python. The meta data of the message (context, whether it should be
+ * displayed) is taken from the calling thread by the callback.
  * @param message Triggered message.
  */
-typedef void GtpyOutputChangedCB(const QString& contextName,
-                                 const bool output, const bool error,
-                                 const QString& message);
+typedef void GtpyOutputChangedCB(const QString& message);
+
+/**
+ * @brief Declares the callback that is called from the flush() function in
+ * Python to pass on the pending messages of the calling thread.
+ */
+typedef void GtpyOutputFlushCB();
 
 /**
   * @brief The stdout redirection class.
@@ -41,6 +43,7 @@ typedef struct
 {
     PyObject_HEAD
     GtpyOutputChangedCB* callback;
+    GtpyOutputFlushCB* flushCallback;
     int softspace;
     bool closed;
 } GtpyStdOutRedirect;
@@ -8,8 +8,13 @@
  * Author: Marvin Noethen (DLR AT-TWK)
  */
 
+#include <functional>
+
 #include <QAbstractItemView>
+#include <QApplication>
+#include <QPointer>
 #include <QScrollBar>
+#include <QThreadPool>
 #include <QToolTip>
 #include <QMultiMap>
 
@@ -17,8 +22,44 @@
 
 #include "gtpy_completer.h"
 
+namespace
+{
+
+class IntrospectionRunnable : public QRunnable
+{
+public:
+    explicit IntrospectionRunnable(std::function<void()> func) :
+        m_func(std::move(func))
+    {}
+
+    void run() override { m_func(); }
+
+private:
+    std::function<void()> m_func;
+};
+
+/**
+ * Introspections hold the GIL, so they run one after another. A single
+ * thread also lets queued requests that became outdated be skipped.
+ * Intentionally leaked, since it may still wait for the GIL on shutdown.
+ */
+QThreadPool*
+introspectionPool()
+{
+    static auto* pool = [](){
+        auto* p = new QThreadPool;
+        p->setMaxThreadCount(1);
+        return p;
+    }();
+
+    return pool;
+}
+
+} // namespace
+
 GtpyCompleter::GtpyCompleter(int contextId, QWidget* widget) :
-    QCompleter(widget)
+    QCompleter(widget),
+    m_generation(std::make_shared<std::atomic<int>>(0))
 {
     setObjectName("Python Completer");
     m_contextId = contextId;
@@ -36,6 +77,12 @@ GtpyCompleter::GtpyCompleter(int contextId, QWidget* widget) :
 
     connect(this, SIGNAL(highlighted(QModelIndex)), this,
             SLOT(completionToolTip(QModelIndex)));
+
+    // evaluations may change the namespace of the context
+    connect(GtpyContextManager::instance(),
+            &GtpyContextManager::scriptEvaluated, this, [this](int id){
+        if (id == m_contextId) invalidateIndex();
+    });
 }
 
 void
@@ -46,7 +93,6 @@ GtpyCompleter::handleTabCompletion(QTextCursor textCursor, QRect cursorRect)
         return;
     }
 
-    static int spaceCount = 0;
     int pos = textCursor.position();
 
     textCursor.select(QTextCursor::LineUnderCursor);
@@ -54,12 +100,13 @@ GtpyCompleter::handleTabCompletion(QTextCursor textCursor, QRect cursorRect)
     pos -= textCursor.selectionStart();
 
     QString line = textCursor.selectedText();
-    QString textToComplete = getTextToComplete(pos, line, spaceCount);
+    QString textToComplete = getTextToComplete(pos, line, m_spaceCount);
 
-    spaceCount = 0;
+    m_spaceCount = 0;
 
     if (textToComplete.isEmpty())
     {
+        cancelIndexRequest();
         QCompleter::popup()->hide();
         return;
     }
@@ -74,35 +121,123 @@ GtpyCompleter::handleTabCompletion(QTextCursor textCursor, QRect cursorRect)
         textToComplete = textToComplete.mid(dot + 1, pos);
     }
 
-    QMultiMap<QString, GtpyFunction> completions;
-    completions = getCompletions(textToComplete, objToLookup);
-
-    if (completions.isEmpty())
+    if (textToComplete.isEmpty() && objToLookup.isEmpty())
     {
+        cancelIndexRequest();
         QCompleter::popup()->hide();
         return;
     }
-    else
+
+    m_request.text = textToComplete.toLower();
+    m_request.dot = dot;
+    m_request.indexOfCompletion = m_indexOfCompletion;
+    m_request.cursorRect = cursorRect;
+
+    const bool modules = m_request.text.contains(
+                QRegularExpression("from|import"));
+
+    // the index is reused while the same word is typed, a request that is
+    // still running shows its completions when it is finished
+    if (m_index.object != objToLookup || m_index.modules != modules ||
+        m_index.prefix.isEmpty() ||
+        !m_request.text.startsWith(m_index.prefix) ||
+        (m_index.ready && m_index.completions.isEmpty()))
     {
-        m_model->setFound(completions);
+        requestIndex(objToLookup, modules);
+        return;
+    }
 
-        m_indexOfCompletion += dot + 1;
-        m_sizeOfCompletion   = textToComplete.size();
+    if (m_index.ready)
+    {
+        showCompletions();
+    }
+}
 
-        cursorRect.setWidth(QCompleter::popup()->sizeHintForColumn(0) +
-                            QCompleter::popup()->verticalScrollBar()->
-                            sizeHint().width());
+void
+GtpyCompleter::requestIndex(const QString& objToLookup, bool modules)
+{
+    const int generation = ++(*m_generation);
+
+    m_index.object = objToLookup;
+    m_index.modules = modules;
+    m_index.prefix = m_request.text;
+    m_index.ready = false;
+    m_index.completions = {};
+
+    QPointer<GtpyCompleter> self{this};
+    auto currentGeneration = m_generation;
+    const int contextId = m_contextId;
+
+    introspectionPool()->start(new IntrospectionRunnable([=](){
+        // skip requests that were replaced while they were queued
+        if (*currentGeneration != generation) return;
+
+        auto completions = GtpyContextManager::instance()->introspection(
+                    contextId, objToLookup, modules);
+
+        // the application object outlives the completer
+        QMetaObject::invokeMethod(qApp, [=](){
+            if (self) self->onIndexReady(generation, completions);
+        }, Qt::QueuedConnection);
+    }));
+}
 
-        cursorRect.translate(0, 8);
+void
+GtpyCompleter::onIndexReady(int generation,
+                            const QMultiMap<QString, GtpyFunction>& completions)
+{
+    if (generation != *m_generation) return;
+
+    m_index.completions = GtpyCompletionIndex{completions};
+    m_index.ready = true;
+
+    showCompletions();
+}
+
+void
+GtpyCompleter::cancelIndexRequest()
+{
+    if (!m_index.ready) invalidateIndex();
+}
+
+void
+GtpyCompleter::invalidateIndex()
+{
+    ++(*m_generation);
+    m_index = {};
+}
+
+void
+GtpyCompleter::showCompletions()
+{
+    auto completions = m_index.completions.find(m_request.text);
 
-        complete(cursorRect);
+    if (completions.isEmpty())
+    {
+        QCompleter::popup()->hide();
+        return;
     }
 
-    foreach (QString name, completions.keys())
+    m_model->setFound(completions);
+
+    m_indexOfCompletion = m_request.indexOfCompletion + m_request.dot + 1;
+    m_sizeOfCompletion  = m_request.text.size();
+
+    QRect cursorRect = m_request.cursorRect;
+    cursorRect.setWidth(QCompleter::popup()->sizeHintForColumn(0) +
+                        QCompleter::popup()->verticalScrollBar()->
+                        sizeHint().width());
+
+    cursorRect.translate(0, 8);
+
+    complete(cursorRect);
+
+    for (auto iter = completions.keyBegin(); iter != completions.keyEnd();
+         ++iter)
     {
-        if (name.contains(' '))
+        if (iter->contains(' '))
         {
-            spaceCount = name.count(' ');
+            m_spaceCount = iter->count(' ');
             return;
         }
     }
@@ -150,68 +285,6 @@ GtpyCompleter::getTextToComplete(int pos, QString line, int spaces)
     return match.captured();
 }
 
-QMultiMap<QString, GtpyFunction>
-GtpyCompleter::getCompletions(QString textToCompare, QString objToLookup)
-{
-    if (textToCompare.isEmpty() && objToLookup.isEmpty())
-    {
-        return QMultiMap<QString, GtpyFunction>();
-    }
-
-    textToCompare = textToCompare.toLower();
-
-    static QString oldTextToCompare;
-
-    static QString oldObjToLookup;
-
-    static QMultiMap<QString, GtpyFunction> completions;
-
-    QMultiMap<QString, GtpyFunction> map;
-
-    if (textToCompare == QStringLiteral("import") ||
-            textToCompare == QStringLiteral("from"))
-    {
-        GtpyContextManager* python = GtpyContextManager::instance();
-        map = python->introspection(m_contextId, objToLookup, true);
-    }
-    else if (completions.isEmpty() || oldTextToCompare.isEmpty() ||
-             !textToCompare.startsWith(oldTextToCompare) ||
-             oldObjToLookup != objToLookup)
-    {
-        GtpyContextManager* python = GtpyContextManager::instance();
-
-        if (textToCompare.contains(QRegularExpression("from|import")))
-        {
-            map = python->introspection(m_contextId, objToLookup, true);
-        }
-        else
-        {
-            map = python->introspection(m_contextId, objToLookup);
-        }
-    }
-    else
-    {
-        map = completions;
-    }
-
-    completions.clear();
-
-    for (int i = 0; i < map.size(); i++)
-    {
-        QString name = map.keys().at(i);
-
-        if (name.toLower().startsWith(textToCompare.toLower()))
-        {
-            completions.insert(name, map.values().at(i));
-        }
-    }
-
-    oldTextToCompare = textToCompare;
-    oldObjToLookup   = objToLookup;
-
-    return completions;
-}
-
 QAbstractItemView*
 GtpyCompleter::getPopup() const
 {
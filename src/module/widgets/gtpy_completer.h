@@ -11,10 +11,14 @@
 #ifndef GTPY_COMPLETER_H
 #define GTPY_COMPLETER_H
 
+#include <atomic>
+#include <memory>
+
 #include <QCompleter>
 #include <QTextCursor>
 
 #include "gtpy_contextmanager.h"
+#include "gtpy_completionindex.h"
 
 class GtpyCompleterModel;
 /**
@@ -101,14 +105,39 @@ private:
     QString getTextToComplete(int pos, QString line, int spaces = 0);
 
     /**
-     * @brief Returns all completions found for 'textToComplete'. Stores the
-     * completions for the next call to minimize searching in a large map
-     * @param textToCompare Word for which completions are searched for
-     * @param objToLookup An object to look up completions for in introspection
-     * @return Matching completions
+     * @brief Introspects the given object in a background thread and shows
+     * the completions of the current request when it is finished. Requests
+     * that are replaced in the meantime are skipped or discarded.
+     * @param objToLookup Object to look up completions for. The namespace
+     * of the context is used if it is empty.
+     * @param modules True if importable modules should be completed.
+     */
+    void requestIndex(const QString& objToLookup, bool modules);
+
+    /**
+     * @brief Stores the introspection result of the given request and shows
+     * the completions of the current request.
+     * @param generation Generation of the request.
+     * @param completions Introspection result.
+     */
+    void onIndexReady(int generation,
+                      const QMultiMap<QString, GtpyFunction>& completions);
+
+    /**
+     * @brief Discards the result of a running index request.
      */
-    QMultiMap<QString, GtpyFunction> getCompletions(QString textToCompare,
-                                                    QString objToLookup);
+    void cancelIndexRequest();
+
+    /**
+     * @brief Discards the index and the result of a running index request.
+     */
+    void invalidateIndex();
+
+    /**
+     * @brief Shows the completions of the current request found in the
+     * index.
+     */
+    void showCompletions();
 
     /**
      * @brief Compares two Strings and returns the size of the shared part,
@@ -131,6 +160,32 @@ private:
     /// size of completion - used for inserting completion
     int m_sizeOfCompletion;
 
+    /// number of spaces of the last completions
+    int m_spaceCount{0};
+
+    /// Completion request of the last tab completion
+    struct Request
+    {
+        QString text;
+        int dot{-1};
+        int indexOfCompletion{0};
+        QRect cursorRect;
+    } m_request;
+
+    /// Completions of the object of the current word
+    struct Index
+    {
+        QString object;
+        QString prefix;
+        bool modules{false};
+        bool ready{false};
+        GtpyCompletionIndex completions;
+    } m_index;
+
+    /// Generation of the latest index request, shared with the introspection
+    /// thread
+    std::shared_ptr<std::atomic<int>> m_generation;
+
 
 private slots:
     /**
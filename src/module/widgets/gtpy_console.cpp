@@ -15,6 +15,7 @@
 #include <QClipboard>
 #include <QApplication>
 #include <QRegularExpression>
+#include <QMutex>
 
 #include "gt_application.h"
 #include "gt_command.h"
@@ -22,6 +23,7 @@
 #include "gt_project.h"
 
 #include "gtpy_completer.h"
+#include "gtpy_scriptrunnable.h"
 
 #include "gtpy_console.h"
 
@@ -34,8 +36,93 @@ namespace
         return "[" + messagePrefix + "] ";
     }
 
+    /**
+     * @brief Appends the message to the pending text and takes all complete
+     * lines out of it. Each line is preceded by the prefix.
+     * @param pending Text that has not been displayed yet.
+     * @param message New message.
+     * @param prefix Prefix of each line.
+     * @param lines Complete lines separated by line breaks.
+     * @return True if the pending text contained complete lines.
+     */
+    bool takeLines(QString& pending, const QString& message,
+                   const QString& prefix, QString& lines)
+    {
+        pending += message;
+
+        int last = pending.lastIndexOf('\n');
+
+        if (last == -1) return false;
+
+        if (prefix.isEmpty())
+        {
+            lines = pending.left(last);
+        }
+        else
+        {
+            lines.clear();
+
+            int start = 0;
+            while (start <= last)
+            {
+                int idx = pending.indexOf('\n', start);
+
+                if (start > 0) lines += '\n';
+                lines += prefix;
+                lines += pending.mid(start, idx - start);
+
+                start = idx + 1;
+            }
+        }
+
+        pending.remove(0, last + 1);
+
+        return true;
+    }
+
+    /// Maximum number of characters queued for the console. Older output is
+    /// dropped if a script writes faster than the console shows it.
+    constexpr int MAX_QUEUED_SIZE = 1 << 20;
+
 } // namespace
 
+/**
+ * Output of the Python contexts shown by the console. Evaluations running in
+ * worker threads append to it directly, and the console takes the queued
+ * messages in the GUI thread. It is shared with the connections, so that it
+ * outlives a message that is emitted while the console is destroyed.
+ */
+struct GtpyConsole::OutputQueue
+{
+    struct Message
+    {
+        QString text;
+        int contextId;
+        QString prefix;
+        bool error;
+    };
+
+    /// Guards all members
+    QMutex mutex;
+
+    QList<Message> messages;
+
+    /// Number of queued characters
+    int size{0};
+
+    /// Whether messages were dropped since the last drain
+    bool truncated{false};
+
+    /// Whether a drain of the console is pending
+    bool drainPosted{false};
+
+    /// Contexts whose output is queued
+    QList<int> contexts;
+
+    /// Receiver of the queued messages, null once it is destroyed
+    GtpyConsole* console{nullptr};
+};
+
 const QRegularExpression GtpyConsole::RE_KEYBOARD_INTERRUPT
 ("Traceback.*\\n(\\s*File.*\\n)+(.*\\n)?KeyboardInterrupt");
 const QRegularExpression GtpyConsole::RE_ERROR_LINE
@@ -49,6 +136,8 @@ GtpyConsole::GtpyConsole(int contextId,
     setFrameStyle(QFrame::NoFrame);
 
     setCommandPrompt("GTlab");
+    setMaximumLineCount(DEFAULT_MAX_LINES);
+
     const QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
 
     setFont(font);
@@ -66,10 +155,52 @@ GtpyConsole::GtpyConsole(int contextId,
 
     m_python = GtpyContextManager::instance();
 
-    connect(m_python, SIGNAL(pythonMessage(const QString&, int, const QString&)), this,
-            SLOT(stdOut(const QString&, int, const QString&)));
-    connect(m_python, SIGNAL(errorMessage(const QString&, int, const QString&)),
-            this, SLOT(stdErr(const QString&, int, const QString&)));
+    m_output = std::make_shared<OutputQueue>();
+    m_output->console = this;
+    m_output->contexts.append(m_contextId);
+
+    // messages are queued in the emitting thread, e.g. the worker thread of
+    // an evaluation, and shown in the GUI thread
+    auto queue = m_output;
+
+    auto enqueue = [queue](const QString& text, int contextId,
+                           const QString& prefix, bool error){
+        QMutexLocker locker{&queue->mutex};
+
+        if (!queue->console || !queue->contexts.contains(contextId)) return;
+
+        queue->messages.append({text, contextId, prefix, error});
+        queue->size += text.size();
+
+        while (queue->size > MAX_QUEUED_SIZE && queue->messages.size() > 1)
+        {
+            queue->size -= queue->messages.takeFirst().text.size();
+            queue->truncated = true;
+        }
+
+        if (queue->drainPosted) return;
+
+        queue->drainPosted = true;
+
+        // posted while locked, so the console is not destroyed meanwhile
+        auto* console = queue->console;
+        QMetaObject::invokeMethod(console, [console](){
+            console->drainOutput();
+        }, Qt::QueuedConnection);
+    };
+
+    m_outConnection = connect(
+        m_python, &GtpyContextManager::pythonMessage, m_python,
+        [enqueue](const QString& text, int contextId, const QString& prefix){
+        enqueue(text, contextId, prefix, false);
+    }, Qt::DirectConnection);
+
+    m_errConnection = connect(
+        m_python, &GtpyContextManager::errorMessage, m_python,
+        [enqueue](const QString& text, int contextId, const QString& prefix){
+        enqueue(text, contextId, prefix, true);
+    }, Qt::DirectConnection);
+
     connect(m_python, SIGNAL(startedScriptEvaluation(int)), this,
             SLOT(cursorToEnd(int)));
     connect(m_python, SIGNAL(scriptEvaluated(int)),
@@ -90,6 +221,28 @@ GtpyConsole::GtpyConsole(int contextId,
 #endif
 }
 
+GtpyConsole::~GtpyConsole()
+{
+    disconnect(m_outConnection);
+    disconnect(m_errConnection);
+
+    {
+        QMutexLocker locker{&m_output->mutex};
+        m_output->console = nullptr;
+    }
+
+    if (m_runnable)
+    {
+        m_python->autoDeleteRunnable(m_runnable);
+        m_runnable->interrupt();
+    }
+
+    if (m_command && gtApp)
+    {
+        gtApp->endCommand(*m_command);
+    }
+}
+
 void
 GtpyConsole::setCommandPrompt(const QString& commandPrompt)
 {
@@ -104,6 +257,9 @@ GtpyConsole::showAdditionalContextOutput(int contextId)
     if (!m_additionalContextOutput.contains(contextId))
     {
         m_additionalContextOutput.append(contextId);
+
+        QMutexLocker locker{&m_output->mutex};
+        m_output->contexts.append(contextId);
     }
 }
 
@@ -115,6 +271,37 @@ GtpyConsole::removeAdditionalContextOutput(int contextId)
     if (index > -1)
     {
         m_additionalContextOutput.removeAt(index);
+
+        QMutexLocker locker{&m_output->mutex};
+        m_output->contexts.removeOne(contextId);
+    }
+}
+
+void
+GtpyConsole::drainOutput()
+{
+    QList<OutputQueue::Message> messages;
+    bool truncated{false};
+
+    {
+        QMutexLocker locker{&m_output->mutex};
+
+        std::swap(messages, m_output->messages);
+        std::swap(truncated, m_output->truncated);
+
+        m_output->size = 0;
+        m_output->drainPosted = false;
+    }
+
+    if (truncated)
+    {
+        stdErr(QStringLiteral("[... output truncated ...]\n"), m_contextId);
+    }
+
+    for (const auto& msg : qAsConst(messages))
+    {
+        if (msg.error) stdErr(msg.text, msg.contextId, msg.prefix);
+        else stdOut(msg.text, msg.contextId, msg.prefix);
     }
 }
 
@@ -124,17 +311,13 @@ GtpyConsole::stdErr(const QString& message, int contextId, const QString& messag
     if (m_contextId == contextId ||
             m_additionalContextOutput.contains(contextId))
     {
-        setTextColor(QColor(214, 0, 0));
+        QString lines;
 
-        m_stdErr += message;
-        int idx;
-
-        auto prefix = consolePrefix(messagePrefix);
-        while ((idx = m_stdErr.indexOf('\n')) != -1)
+        if (takeLines(m_stdErr, message, consolePrefix(messagePrefix), lines))
         {
-            consoleMessage(prefix + m_stdErr.left(idx));
-            std::cerr << prefix.toStdString() << m_stdErr.left(idx).toLatin1().data() << std::endl;
-            m_stdErr = m_stdErr.mid(idx + 1);
+            setTextColor(QColor(214, 0, 0));
+            consoleMessage(lines);
+            std::cerr << lines.toLatin1().data() << std::endl;
         }
     }
 }
@@ -156,6 +339,24 @@ GtpyConsole::keyPressEvent(QKeyEvent* e)
 
     QToolTip::showText(QPoint(), "");
 
+    // input is blocked during an evaluation, Ctrl+C without a selection
+    // interrupts it
+    if (m_runnable)
+    {
+        if (!e->matches(QKeySequence::Copy))
+        {
+            e->accept();
+            return;
+        }
+
+        if (!textCursor().hasSelection())
+        {
+            m_runnable->interrupt();
+            e->accept();
+            return;
+        }
+    }
+
     if (m_cpl->getPopup()->isVisible())
     {
         switch (e->key())
@@ -449,6 +650,11 @@ GtpyConsole::executeLine(bool storeOnly)
 void
 GtpyConsole::executeCode(const QString& code)
 {
+    if (m_runnable)
+    {
+        return;
+    }
+
     QTextCursor cursor = this->textCursor();
     cursor.movePosition(QTextCursor::End);
     setTextCursor(cursor);
@@ -458,21 +664,36 @@ GtpyConsole::executeCode(const QString& code)
     m_stdOut = "";
     m_stdErr = "";
 
-    GtCommand com = gtApp->startCommand(gtApp->currentProject(),
-                                        "Python Command");
+    m_command = std::make_unique<GtCommand>(
+                gtApp->startCommand(gtApp->currentProject(),
+                                    "Python Command"));
 
-    if (code.indexOf("\n") != -1)
-    {
-        m_python->evalScript(m_contextId, code, true, true,
-                             GtpyContextManager::EvalFile);
-    }
-    else
+    const auto option = code.indexOf("\n") != -1 ?
+                GtpyContextManager::EvalFile :
+                GtpyContextManager::EvalSingleString;
+
+    // evaluate in a worker thread to keep the application responsive,
+    // the output is received via the signals of the context manager
+    m_runnable = m_python->evalScriptAsync(m_contextId, code, this,
+                                           [this](bool){
+        onEvaluationFinished();
+    }, true, option);
+}
+
+void
+GtpyConsole::onEvaluationFinished()
+{
+    if (m_command)
     {
-        m_python->evalScript(m_contextId, code, true, true,
-                             GtpyContextManager::EvalSingleString);
+        gtApp->endCommand(*m_command);
+        m_command.reset();
     }
 
-    gtApp->endCommand(com);
+    delete m_runnable;
+
+    QTextCursor cursor = textCursor();
+    cursor.movePosition(QTextCursor::End);
+    setTextCursor(cursor);
 }
 
 int
@@ -647,34 +868,32 @@ GtpyConsole::storeLine(int* insertTab)
     return storeOnly;
 }
 
-void
-GtpyConsole::hideKeyboardInterruptException()
+QString
+GtpyConsole::hideKeyboardInterruptException(const QString& message) const
 {
-    QString error = this->toPlainText();
+    QRegularExpressionMatch matchError = RE_KEYBOARD_INTERRUPT.match(message);
 
-    if (error.indexOf(RE_KEYBOARD_INTERRUPT) == -1)
+    if (!matchError.hasMatch())
     {
-        return;
+        return message;
     }
 
-    QRegularExpressionMatch matchError = RE_KEYBOARD_INTERRUPT.match(error);
     QRegularExpressionMatch matchLine  = RE_ERROR_LINE.match(
             matchError.captured());
 
     // extract lineNumber, size of RE_ERROR_LINE until digit is 17
     int lineNumber = matchLine.captured().mid(17).toInt();
 
-    QString output = error;
     QString interruptString;
     interruptString += " --- Interrupted script at line ";
     interruptString += QString::number(lineNumber);
     interruptString += + " --- ";
 
-    output.replace(matchError.captured(), interruptString);
+    QString output = message;
+    output.replace(matchError.capturedStart(), matchError.capturedLength(),
+                   interruptString);
 
-    cache.flush();
-    this->clear();
-    this->insertPlainText(output);
+    return output;
 }
 
 void
@@ -683,15 +902,12 @@ GtpyConsole::stdOut(const QString& message, int contextId, const QString& messag
     if (m_contextId == contextId ||
             (m_additionalContextOutput.contains(contextId)))
     {
-        m_stdOut += message;
-        int idx;
+        QString lines;
 
-        auto prefix = consolePrefix(messagePrefix);
-        while ((idx = m_stdOut.indexOf('\n')) != -1)
+        if (takeLines(m_stdOut, message, consolePrefix(messagePrefix), lines))
         {
-            consoleMessage(prefix + m_stdOut.left(idx));
-            std::cout <<  prefix.toStdString() << m_stdOut.left(idx).toLatin1().data() << std::endl;
-            m_stdOut = m_stdOut.mid(idx + 1);
+            consoleMessage(lines);
+            std::cout << lines.toLatin1().data() << std::endl;
         }
     }
 }
@@ -699,6 +915,8 @@ GtpyConsole::stdOut(const QString& message, int contextId, const QString& messag
 void
 GtpyConsole::cursorToEnd(int contextId)
 {
+    drainOutput();
+
     if (contextId == m_contextId ||
             m_additionalContextOutput.contains(contextId))
     {
@@ -751,6 +969,9 @@ GtpyConsole::appendCommandPrompt(int contextId, bool storeOnly)
 void
 GtpyConsole::onCodeExecuted(int contextId)
 {
+    // the output of the evaluation is queued before this notification
+    drainOutput();
+
     if (contextId == m_contextId ||
             m_additionalContextOutput.contains(contextId))
     {
@@ -799,14 +1020,27 @@ GtpyConsole::insertCompletion()
 }
 
 void
-GtpyConsole::consoleMessage(const QString& message)
+GtpyConsole::setMaximumLineCount(int lines)
 {
-    QTextCursor cursor = textCursor();
-    cursor.movePosition(QTextCursor::End);
-    setTextCursor(cursor);
-    cache.append("\n" + message);
+    cache.flush();
+
+    // the document drops the oldest blocks once the limit is exceeded
+    document()->setMaximumBlockCount(lines);
+}
+
+int
+GtpyConsole::maximumLineCount() const
+{
+    return document()->maximumBlockCount();
+}
 
-    hideKeyboardInterruptException();
+void
+GtpyConsole::consoleMessage(const QString& message)
+{
+    // only the new message is checked, the text of the document is not
+    // scanned again for each message
+    cache.append("\n" + hideKeyboardInterruptException(message),
+                 currentCharFormat());
 
     setCurrentCharFormat(m_defaultTextCharacterFormat);
 }
@@ -821,18 +1055,44 @@ GtpyConsole::ConsoleCache::ConsoleCache(QTextEdit & edit)
 }
 
 void 
-GtpyConsole::ConsoleCache::append(const QString& text)
+GtpyConsole::ConsoleCache::append(const QString& text,
+                                  const QTextCharFormat& format)
 {
-    cacheStr += text;
-    timer.start(30);
+    // consecutive messages of the same kind are inserted as one chunk
+    if (!chunks.isEmpty() && chunks.last().format == format)
+    {
+        chunks.last().text += text;
+    }
+    else
+    {
+        chunks.append({text, format});
+    }
+
+    if (!timer.isActive()) timer.start(30);
 }
 
 void
 GtpyConsole::ConsoleCache::flush()
 {
-    if (cacheStr.isEmpty()) return;
+    if (chunks.isEmpty()) return;
 
     timer.stop();
-    edit.insertPlainText(cacheStr);
-    cacheStr.clear();
+
+    // the input continues with the format used before
+    const auto inputFormat = edit.currentCharFormat();
+
+    QTextCursor cursor{edit.document()};
+    cursor.movePosition(QTextCursor::End);
+
+    cursor.beginEditBlock();
+    for (const auto& chunk : qAsConst(chunks))
+    {
+        cursor.insertText(chunk.text, chunk.format);
+    }
+    cursor.endEditBlock();
+
+    chunks.clear();
+
+    edit.setTextCursor(cursor);
+    edit.setCurrentCharFormat(inputFormat);
 }
@@ -11,12 +11,17 @@
 #ifndef GTPY_CONSOLE_H
 #define GTPY_CONSOLE_H
 
+#include <memory>
+
+#include <QPointer>
 #include <QTextEdit>
 #include <QTimer>
 
 #include "gtpy_contextmanager.h"
 
+class GtCommand;
 class GtpyCompleter;
+class GtpyScriptRunnable;
 class GtPyCompleterModel;
 
 /**
@@ -35,12 +40,34 @@ public:
      */
     GtpyConsole(int contextId, QWidget* parent);
 
+    /**
+     * @brief Interrupts a running evaluation.
+     */
+    ~GtpyConsole() override;
+
     /**
      * @brief Sets the text of command prompt of the console.
      * @param commandPrompt Text of command prompt.
      */
     void setCommandPrompt(const QString& commandPrompt);
 
+    /**
+     * @brief Sets the maximum number of lines kept in the console. The
+     * oldest lines are removed once the limit is exceeded. A value of zero
+     * or less means no limit.
+     * @param lines Maximum number of lines.
+     */
+    void setMaximumLineCount(int lines);
+
+    /**
+     * @brief Returns the maximum number of lines kept in the console.
+     * @return Maximum number of lines.
+     */
+    int maximumLineCount() const;
+
+    /// Default maximum number of lines kept in the console
+    static constexpr int DEFAULT_MAX_LINES = 50000;
+
 public slots:
     /**
      * @brief Enables the registration of a context whose output is displayed
@@ -125,17 +152,47 @@ private:
     /// Cursor Position
     int m_cursorPosition;
 
+    /// Evaluation of the last input, null if no input is evaluated
+    QPointer<GtpyScriptRunnable> m_runnable;
+
+    /// Command of the running evaluation
+    std::unique_ptr<GtCommand> m_command;
+
+    struct OutputQueue;
+
+    /// Bounded queue of the output that is not shown yet
+    std::shared_ptr<OutputQueue> m_output;
+
+    /// Connections that queue the output of the context manager
+    QMetaObject::Connection m_outConnection;
+    QMetaObject::Connection m_errConnection;
+
+    /**
+     * @brief Shows the queued output in the console.
+     */
+    void drainOutput();
+
+    /**
+     * Collects the messages and inserts them in chunks of the same format
+     * into the document at most every 30 ms.
+     */
     class ConsoleCache
     {
     public:
         explicit ConsoleCache(QTextEdit&);
 
-        void append(const QString& text);
+        void append(const QString& text, const QTextCharFormat& format);
         void flush();
 
     private:
+        struct Chunk
+        {
+            QString text;
+            QTextCharFormat format;
+        };
+
         QTextEdit& edit;
-        QString cacheStr;
+        QList<Chunk> chunks;
         QTimer timer;
     };
 
@@ -148,11 +205,17 @@ private:
     void executeLine(bool storeOnly);
 
     /**
-     * @brief Executes the given python code.
+     * @brief Executes the given python code in a worker thread. Input is
+     * blocked until the evaluation is finished.
      * @param code Python code.
      */
     void executeCode(const QString& code);
 
+    /**
+     * @brief Ends the command of the evaluation and accepts input again.
+     */
+    void onEvaluationFinished();
+
     /**
      * @brief Returns the position of the command prompt.
      * @return Position of the command prompt
@@ -198,11 +261,13 @@ private:
     bool storeLine(int* tabCount);
 
     /**
-     * @brief chekcs if the error message of the python exception
-     * 'KeyboardInterrupt' was send to the console. If so it replaces it with a
+     * @brief chekcs if the given message contains the error message of the
+     * python exception 'KeyboardInterrupt'. If so it replaces it with a
      * propper message
+     * @param message Message that should be inserted.
+     * @return The message to insert.
      */
-    void hideKeyboardInterruptException();
+    QString hideKeyboardInterruptException(const QString& message) const;
 
 private slots:
 
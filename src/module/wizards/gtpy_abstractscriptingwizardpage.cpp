@@ -645,24 +645,10 @@ GtpyAbstractScriptingWizardPage::evalScript(const QString& script,
 
     m_isEvaluating = true;
 
-    m_runnable = new GtpyScriptRunnable(m_contextId);
-
-    m_runnable->setScript(script);
-    m_runnable->setOutputToConsole(outputToConsole);
-
-    // make runnable not delete itself
-    m_runnable->setAutoDelete(false);
-
-    // connect runnable signals to wizard slots
-    connect(m_runnable, SIGNAL(runnableFinished()),
-            this, SLOT(evaluationFinished()));
-
-    QThreadPool* tp = QThreadPool::globalInstance();
-
-    // start runnable
-    tp->start(m_runnable);
-
-    return;
+    m_runnable = GtpyContextManager::instance()->evalScriptAsync(
+                m_contextId, script, this, [this](bool){
+        evaluationFinished();
+    }, outputToConsole);
 }
 
 void
@@ -1110,10 +1096,6 @@ GtpyAbstractScriptingWizardPage::evaluationFinished()
     {
         bool success = m_runnable->successful();
 
-        // connect runnable signals to task runner slots
-        disconnect(m_runnable, &GtpyScriptRunnable::runnableFinished,
-                   this, &GtpyAbstractScriptingWizardPage::evaluationFinished);
-
         delete m_runnable;
         m_runnable = nullptr;
 
@@ -7,7 +7,9 @@
 #define FIND_LIBPYTHON_H
 
 /**
- * This code is copied from the find_libpython module
+ * This code is copied from the find_libpython module. It only defines
+ * find_libpython() and the command line interface, the caller appends the
+ * code that uses them.
  */
 
 constexpr const char* findPythonLibCode = R"(
@@ -449,9 +451,6 @@ def main(args=None):
     ns = parser.parse_args(args)
     parser.exit(_cli_find_libpython(**vars(ns)))
 
-# custom addition
-main()
-
 )";
 
 #endif // FIND_LIBPYTHON_H
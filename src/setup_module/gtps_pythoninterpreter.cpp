@@ -19,15 +19,181 @@
 #include <QDir>
 #include <QFileInfo>
 #include <QTemporaryFile>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace
+{
+
+/// Version of the cache file format. Entries of other versions are ignored.
+constexpr int PROBE_CACHE_FORMAT = 2;
+
+/// Code appended to find_libpython to print all interpreter details at once.
+/// The directory of the temporary probe script is not a sys path of the
+/// interpreter, so it is removed.
+constexpr const char* probeCode = R"(
+import json
+import os
+import sys
+
+try:
+    libpython = find_libpython() or ""
+except Exception:
+    libpython = ""
+
+script_dir = os.path.dirname(os.path.abspath(__file__))
+
+sys.stdout.write(json.dumps({
+    "version": "%s.%s.%s" % sys.version_info[:3],
+    "sharedLib": libpython,
+    "sysPaths": [x for x in sys.path
+                 if x and os.path.abspath(x) != script_dir],
+}))
+)";
+
+QString
+probeCacheFile()
+{
+    auto dir = QStandardPaths::writableLocation(
+                QStandardPaths::CacheLocation);
+
+    if (dir.isEmpty()) return {};
+
+    return QDir{dir}.filePath(QStringLiteral("python_interpreters.json"));
+}
+
+QJsonObject
+readProbeCache()
+{
+    auto fileName = probeCacheFile();
+    if (fileName.isEmpty()) return {};
+
+    QFile file{fileName};
+    if (!file.open(QIODevice::ReadOnly)) return {};
+
+    auto cache = QJsonDocument::fromJson(file.readAll()).object();
+
+    if (cache.value("format").toInt() != PROBE_CACHE_FORMAT) return {};
+
+    return cache;
+}
+
+qint64
+lastModified(const QString& path)
+{
+    QFileInfo info{path};
+    return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+/**
+ * @brief Returns the modification times of the given sys paths. Installing
+ * a package that adds a .pth file changes the time of its site-packages
+ * directory, which invalidates the cached sys paths.
+ */
+QJsonObject
+pathStamps(const QStringList& paths)
+{
+    QJsonObject stamps;
+
+    for (const auto& path : paths)
+    {
+        stamps.insert(path, lastModified(path));
+    }
+
+    return stamps;
+}
+
+/**
+ * @brief Returns the cached probe result of the given Python executable or
+ * an empty object if there is none or it is outdated.
+ */
+QJsonObject
+cachedProbe(const QFileInfo& exe)
+{
+    auto entry = readProbeCache().value("interpreters").toObject()
+            .value(exe.absoluteFilePath()).toObject();
+
+    if (entry.isEmpty() ||
+        entry.value("lastModified").toVariant().toLongLong() !=
+        exe.lastModified().toMSecsSinceEpoch() ||
+        entry.value("size").toVariant().toLongLong() != exe.size())
+    {
+        return {};
+    }
+
+    auto stamps = entry.value("pathStamps").toObject();
+
+    for (auto iter = stamps.constBegin(); iter != stamps.constEnd(); ++iter)
+    {
+        if (iter.value().toVariant().toLongLong() != lastModified(iter.key()))
+        {
+            return {};
+        }
+    }
+
+    return entry.value("probe").toObject();
+}
+
+void
+storeProbe(const QFileInfo& exe, const QJsonObject& probe)
+{
+    auto fileName = probeCacheFile();
+    if (fileName.isEmpty()) return;
+
+    QDir{}.mkpath(QFileInfo{fileName}.absolutePath());
+
+    QStringList paths;
+    for (const auto& path : probe.value("sysPaths").toArray())
+    {
+        paths << path.toString();
+    }
+
+    QJsonObject entry;
+    entry.insert("lastModified", exe.lastModified().toMSecsSinceEpoch());
+    entry.insert("size", exe.size());
+    entry.insert("pathStamps", pathStamps(paths));
+    entry.insert("probe", probe);
+
+    auto cache = readProbeCache();
+    auto interpreters = cache.value("interpreters").toObject();
+    interpreters.insert(exe.absoluteFilePath(), entry);
+
+    cache.insert("format", PROBE_CACHE_FORMAT);
+    cache.insert("interpreters", interpreters);
+
+    // several GTlab instances may start at the same time
+    QSaveFile file{fileName};
+    if (!file.open(QIODevice::WriteOnly)) return;
+
+    file.write(QJsonDocument{cache}.toJson(QJsonDocument::Compact));
+
+    if (!file.commit())
+    {
+        gtWarning() << QObject::tr("Could not write the Python interpreter "
+                                   "cache '%1'").arg(fileName);
+    }
+}
+
+} // namespace
 
 GtpsPythonInterpreter::GtpsPythonInterpreter(const QString& pythonExe) :
         m_pythonExe{pythonExe}
 {
-    if (isValid())
+    // only executables given as file can be identified in the cache
+    QFileInfo exe{pythonExe};
+    bool cacheable = exe.isFile();
+
+    if (cacheable && applyProbe(cachedProbe(exe))) return;
+
+    auto probe = runProbe();
+
+    if (applyProbe(probe) && cacheable)
     {
-        setPythonVersion();
-        setSharedLibPath();
-        setSysPaths();
+        storeProbe(exe, probe);
     }
 }
 
@@ -133,64 +299,46 @@ GtpsPythonInterpreter::pythonHomePath() const
     return QDir::toNativeSeparators(QFileInfo(m_pythonExe).absolutePath());
 }
 
-void
-GtpsPythonInterpreter::setPythonVersion()
+QJsonObject
+GtpsPythonInterpreter::runProbe() const
 {
-    QString pyCode{"import sys;"
-                   "sys.stdout.write('%s.%s.%s' % (sys.version_info.major, "
-                   "sys.version_info.minor, sys.version_info.micro))"};
+    QTemporaryFile file;
+    if (!file.open()) return {};
+
+    file.write(findPythonLibCode);
+    file.write(probeCode);
+    file.flush();
 
     bool ok{false};
-    auto version = runCommand(pyCode, &ok);
+    auto output = runScript(file, &ok);
 
-    if (ok)
-    {
-        m_pyVersion = GtVersionNumber{version};
+    if (!ok) return {};
 
-        if (!gtps::python::version::isSupported(m_pyVersion))
-        {
-            m_status = Status::NotSupported;
-        }
-    }
+    return QJsonDocument::fromJson(output.toUtf8()).object();
 }
 
-std::unique_ptr<QTemporaryFile>
-getFindLibPythonScriptFile()
+bool
+GtpsPythonInterpreter::applyProbe(const QJsonObject& probe)
 {
-    auto file = std::make_unique<QTemporaryFile>();
-    if (file->open())
+    auto version = probe.value("version").toString();
+
+    if (version.isEmpty())
     {
-        file->write(findPythonLibCode);
-        file->flush();
+        m_status = Status::Invalid;
+        return false;
     }
-    return file;
-}
 
-void
-GtpsPythonInterpreter::setSharedLibPath()
-{
-    bool ok{false};
-    auto sharedLib = runScript(*getFindLibPythonScriptFile(), &ok);
+    m_pyVersion = GtVersionNumber{version};
+    m_sharedLib = probe.value("sharedLib").toString();
 
-    if (ok)
+    m_sysPaths.clear();
+    for (const auto& path : probe.value("sysPaths").toArray())
     {
-        m_sharedLib = sharedLib.replace("\\\\", "\\");
+        m_sysPaths << QDir::toNativeSeparators(path.toString());
     }
-}
 
-void
-GtpsPythonInterpreter::setSysPaths()
-{
-    QString pyCode{"import sys;print(', '.join([x for x in sys.path if x]), "
-                   "end='')"};
-    bool ok{false};
-    auto pyPaths = runCommand(pyCode, &ok);
+    m_status = gtps::python::version::isSupported(m_pyVersion) ?
+                Status::Valid : Status::NotSupported;
 
-    if (ok)
-    {
-        m_sysPaths = pyPaths.split(", ");
-        auto toNativeSep = [](QString& pyPath){
-                            pyPath = QDir::toNativeSeparators(pyPath);};
-        std::for_each(m_sysPaths.begin(), m_sysPaths.end(), toNativeSep);
-    }
+    return true;
 }
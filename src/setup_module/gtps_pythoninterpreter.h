@@ -14,11 +14,17 @@
 #include <QString>
 #include <QStringList>
 #include <QFile>
+#include <QJsonObject>
 
 #include "gt_versionnumber.h"
 
 /**
  * @brief The GtpsPythonInterpreter class
+ *
+ * The details of an interpreter are determined by a single Python process.
+ * They are cached on disk, keyed by the path, modification time and size of
+ * the executable, so that later instances for an unchanged interpreter do
+ * not start any process.
  */
 class GtpsPythonInterpreter
 {
@@ -120,22 +126,18 @@ private:
     Status m_status{Invalid};
 
     /**
-     * @brief Asks the Python interpreter for the Python version and stores
-     * the result in the version variable.
-     */
-    void setPythonVersion();
-
-    /**
-     * @brief Asks the interpreter for the path to the shared library and
-     * stores it in the shared lib variable.
+     * @brief Runs a single Python process that prints the version, the
+     * shared library and the sys paths of the interpreter as JSON.
+     * @return The parsed probe result or an empty object on failure.
      */
-    void setSharedLibPath();
+    QJsonObject runProbe() const;
 
     /**
-     * @brief Asks the interpreter for the paths registered in sys.path and
-     * stores them in the sys paths variable.
+     * @brief Stores the given probe result and updates the status.
+     * @param probe Probe result as returned by runProbe().
+     * @return True if the probe result is valid.
      */
-    void setSysPaths();
+    bool applyProbe(const QJsonObject& probe);
 };
 
 #endif // GTPSPYTHONINTERPRETER_H
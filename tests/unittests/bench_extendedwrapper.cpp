@@ -0,0 +1,110 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: bench_extendedwrapper.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <Python.h>
+
+#include <QTest>
+
+#include "bench_helper.h"
+#include "test_helper.h"
+
+#include <gtpy_decorator.h>
+
+/**
+ * Measures attribute access on wrapped GtObjects. Each iteration evaluates
+ * a loop of 1000 accesses in a script context.
+ */
+class BenchExtendedWrapper : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init()
+    {
+        m_context = std::make_unique<TestPythonContext>();
+        m_calc = std::make_unique<MyCalculator>();
+
+        GtpyContextManager::instance()->addGtObject(m_context->id(), "calc",
+                                                    m_calc.get(), false);
+    }
+
+    void cleanup()
+    {
+        m_context.reset();
+        m_calc.reset();
+    }
+
+    /// Last registered property, the worst case of the former linear scan
+    void propertyAccess()
+    {
+        QBENCHMARK
+        {
+            QVERIFY(eval("for _ in range(1000): calc.objlinkprop\n"));
+        }
+    }
+
+    /// Slot of the PythonQt wrapper, the baseline of any attribute access
+    void slotAccess()
+    {
+        QBENCHMARK
+        {
+            QVERIFY(eval("for _ in range(1000): calc.objectName\n"));
+        }
+    }
+
+    void propertyMiss()
+    {
+        QBENCHMARK
+        {
+            QVERIFY(eval("for _ in range(1000): hasattr(calc, 'unknown')\n"));
+        }
+    }
+
+    /// Child lookups return the live wrapper of the child
+    void childLookup()
+    {
+        auto* child = new MyObject;
+        child->setObjectName("child");
+        m_calc->appendChild(child);
+
+        QBENCHMARK
+        {
+            QVERIFY(eval("for _ in range(1000): calc.child\n"));
+        }
+    }
+
+    /// Wrapping an object whose wrapper is alive reuses it
+    void wrapLiveObject()
+    {
+        GTPY_GIL_SCOPE
+
+        auto live = GtpyDecorator::wrapGtObject(m_calc.get());
+        QVERIFY(live);
+
+        QBENCHMARK
+        {
+            auto wrapper = GtpyDecorator::wrapGtObject(m_calc.get());
+            QCOMPARE(wrapper.get(), live.get());
+        }
+    }
+
+private:
+    std::unique_ptr<TestPythonContext> m_context;
+    std::unique_ptr<MyCalculator> m_calc;
+
+    bool eval(const QString& script)
+    {
+        return GtpyContextManager::instance()->evalScript(m_context->id(),
+                                                          script, false);
+    }
+};
+
+GTPY_REGISTER_BENCHMARK(BenchExtendedWrapper)
+
+#include "bench_extendedwrapper.moc"
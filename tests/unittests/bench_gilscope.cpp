@@ -0,0 +1,58 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: bench_gilscope.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <Python.h>
+
+#include <QTest>
+
+#include "bench_helper.h"
+#include "test_helper.h"
+
+#include <gtpy_gilscope.h>
+
+/**
+ * Measures GTPY_GIL_SCOPE with and without the GIL being held already.
+ */
+class BenchGilScope : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        // initializes Python and releases the GIL of the main thread
+        GtpyContextManager::instance();
+    }
+
+    /// Each scope acquires and releases the GIL
+    void acquiringScope()
+    {
+        QVERIFY(!PyGILState_Check());
+
+        QBENCHMARK
+        {
+            GTPY_GIL_SCOPE
+        }
+    }
+
+    /// Nested scopes skip acquiring the GIL
+    void nestedScope()
+    {
+        GTPY_GIL_SCOPE
+
+        QBENCHMARK
+        {
+            GTPY_GIL_SCOPE
+        }
+    }
+};
+
+GTPY_REGISTER_BENCHMARK(BenchGilScope)
+
+#include "bench_gilscope.moc"
@@ -0,0 +1,49 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: bench_helper.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#ifndef BENCH_HELPER_H
+#define BENCH_HELPER_H
+
+#include <functional>
+#include <memory>
+
+#include <QList>
+#include <QObject>
+
+/// Creates the test object of one benchmark class
+using BenchmarkFactory = std::function<std::unique_ptr<QObject>()>;
+
+/**
+ * @brief Returns the benchmark classes run by the benchmark executable.
+ * @return Factories of the registered benchmark classes.
+ */
+inline QList<BenchmarkFactory>&
+benchmarks()
+{
+    static QList<BenchmarkFactory> list;
+    return list;
+}
+
+/**
+ * Registers a benchmark class when the benchmark executable starts.
+ */
+template <typename T>
+struct BenchmarkRegistration
+{
+    BenchmarkRegistration()
+    {
+        benchmarks().append([](){ return std::unique_ptr<QObject>{new T}; });
+    }
+};
+
+/// Registers the given QTest class containing QBENCHMARK test functions
+#define GTPY_REGISTER_BENCHMARK(T) \
+    static BenchmarkRegistration<T> T##Registration;
+
+#endif // BENCH_HELPER_H
@@ -0,0 +1,28 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: bench_main.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <QCoreApplication>
+#include <QTest>
+
+#include "bench_helper.h"
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+
+    int retval = 0;
+
+    for (const auto& factory : benchmarks())
+    {
+        auto benchmark = factory();
+        retval |= QTest::qExec(benchmark.get(), argc, argv);
+    }
+
+    return retval;
+}
@@ -0,0 +1,89 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: bench_matplotlib.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <Python.h>
+
+#include <QTest>
+
+#include "bench_helper.h"
+#include "test_helper.h"
+
+/**
+ * Measures the startup cost of the lazy matplotlib backend registration
+ * compared with importing pyplot, which the former registration did, and the
+ * cost of the import hook for other imports.
+ */
+class BenchMatplotlib : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        m_context = std::make_unique<TestPythonContext>();
+    }
+
+    void cleanupTestCase()
+    {
+        m_context.reset();
+    }
+
+    /// Startup cost, the hook is installed once per interpreter
+    void registerBackend()
+    {
+        QBENCHMARK_ONCE
+        {
+            QVERIFY(GtpyContextManager::instance()->initMatplotlib());
+        }
+    }
+
+    /// Every import passes the finder of the hook
+    void findSpecWithHook()
+    {
+        QVERIFY(eval("import importlib.util\n"));
+
+        QBENCHMARK
+        {
+            QVERIFY(eval("for _ in range(100): "
+                         "importlib.util.find_spec('json')\n"));
+        }
+    }
+
+    /// First import of pyplot, which is now paid by the scripts using it
+    void importPyplot()
+    {
+        QVERIFY(eval("import importlib.util\n"
+                     "has_mpl = importlib.util.find_spec('matplotlib') "
+                     "is not None\n"));
+
+        if (!GtpyContextManager::instance()->getVariable(
+                m_context->id(), "has_mpl").toBool())
+        {
+            QSKIP("matplotlib is not installed");
+        }
+
+        QBENCHMARK_ONCE
+        {
+            QVERIFY(eval("import matplotlib.pyplot\n"));
+        }
+    }
+
+private:
+    std::unique_ptr<TestPythonContext> m_context;
+
+    bool eval(const QString& script)
+    {
+        return GtpyContextManager::instance()->evalScript(m_context->id(),
+                                                          script, false);
+    }
+};
+
+GTPY_REGISTER_BENCHMARK(BenchMatplotlib)
+
+#include "bench_matplotlib.moc"
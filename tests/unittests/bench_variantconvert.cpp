@@ -0,0 +1,101 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: bench_variantconvert.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <Python.h>
+
+#include <QTest>
+
+#include "bench_helper.h"
+#include "test_helper.h"
+
+#include <gtpypp.h>
+
+/**
+ * Measures the QMap converters of GtpyTypeConversion with maps of 10^5
+ * entries in both directions.
+ */
+class BenchVariantConvert : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        GtpyContextManager::instance()->initContexts();
+
+        for (int i = 0; i < 100000; ++i)
+        {
+            m_doubles.insert(QStringLiteral("key_%1").arg(i), i * 0.5);
+            m_ints.insert(QStringLiteral("key_%1").arg(i), i);
+        }
+    }
+
+    void stringDoubleToPython()
+    {
+        GTPY_GIL_SCOPE
+
+        QBENCHMARK
+        {
+            auto dict = PyPPObject::NewRef(
+                GtpyTypeConversion::convertFromQMapStringDouble(&m_doubles,
+                                                                0));
+            QVERIFY(dict);
+        }
+    }
+
+    void stringDoubleFromPython()
+    {
+        GTPY_GIL_SCOPE
+
+        auto dict = PyPPObject::NewRef(
+            GtpyTypeConversion::convertFromQMapStringDouble(&m_doubles, 0));
+
+        QBENCHMARK
+        {
+            QMap<QString, double> result;
+            QVERIFY(GtpyTypeConversion::convertToQMapStringDouble(
+                        dict.get(), &result, 0, false));
+        }
+    }
+
+    void stringIntToPython()
+    {
+        GTPY_GIL_SCOPE
+
+        QBENCHMARK
+        {
+            auto dict = PyPPObject::NewRef(
+                GtpyTypeConversion::convertFromQMapStringInt(&m_ints, 0));
+            QVERIFY(dict);
+        }
+    }
+
+    void stringIntFromPython()
+    {
+        GTPY_GIL_SCOPE
+
+        auto dict = PyPPObject::NewRef(
+            GtpyTypeConversion::convertFromQMapStringInt(&m_ints, 0));
+
+        QBENCHMARK
+        {
+            QMap<QString, int> result;
+            QVERIFY(GtpyTypeConversion::convertToQMapStringInt(
+                        dict.get(), &result, 0, false));
+        }
+    }
+
+private:
+    QMap<QString, double> m_doubles;
+    QMap<QString, int> m_ints;
+};
+
+GTPY_REGISTER_BENCHMARK(BenchVariantConvert)
+
+#include "bench_variantconvert.moc"
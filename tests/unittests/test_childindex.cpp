@@ -0,0 +1,94 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: test_childindex.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include "test_helper.h"
+
+#include <gtpy_childindex.h>
+#include <gtest/gtest.h>
+
+class TestChildIndex : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        for (int i = 0; i < 2 * gtpy::childindex::MIN_CHILDREN; ++i)
+        {
+            auto* child = new MyObject;
+            child->setObjectName(QStringLiteral("child_%1").arg(i));
+            parent.appendChild(child);
+        }
+    }
+
+    void TearDown() override
+    {
+        gtpy::childindex::setEnabled(true);
+    }
+
+    MyObject parent;
+};
+
+TEST_F(TestChildIndex, FindChild)
+{
+    auto* child = gtpy::childindex::findChild<GtObject*>(&parent, "child_42");
+    ASSERT_TRUE(child != nullptr);
+    EXPECT_EQ("child_42", child->objectName());
+
+    EXPECT_EQ(nullptr,
+              gtpy::childindex::findChild<GtObject*>(&parent, "unknown"));
+}
+
+TEST_F(TestChildIndex, FollowsRenameAddAndRemove)
+{
+    // build the index
+    auto* child = gtpy::childindex::findChild<GtObject*>(&parent, "child_1");
+    ASSERT_TRUE(child != nullptr);
+
+    child->setObjectName("renamed");
+    EXPECT_EQ(nullptr,
+              gtpy::childindex::findChild<GtObject*>(&parent, "child_1"));
+    EXPECT_EQ(child,
+              gtpy::childindex::findChild<GtObject*>(&parent, "renamed"));
+
+    auto* added = new MyObject;
+    added->setObjectName("added");
+    parent.appendChild(added);
+    EXPECT_EQ(added, gtpy::childindex::findChild<GtObject*>(&parent, "added"));
+
+    delete added;
+    EXPECT_EQ(nullptr,
+              gtpy::childindex::findChild<GtObject*>(&parent, "added"));
+}
+
+TEST_F(TestChildIndex, DuplicateNamesKeepChildOrder)
+{
+    auto* first = gtpy::childindex::findChild<GtObject*>(&parent, "child_3");
+    auto* second = gtpy::childindex::findChild<GtObject*>(&parent, "child_7");
+    ASSERT_TRUE(first && second);
+
+    second->setObjectName("child_3");
+
+    auto children = gtpy::childindex::findChildren<GtObject*>(&parent,
+                                                              "child_3");
+    ASSERT_EQ(2, children.size());
+    EXPECT_EQ(first, children.at(0));
+    EXPECT_EQ(second, children.at(1));
+}
+
+TEST_F(TestChildIndex, DisabledIndexFallsBack)
+{
+    gtpy::childindex::setEnabled(false);
+    EXPECT_FALSE(gtpy::childindex::isEnabled());
+
+    auto* child = gtpy::childindex::findChild<GtObject*>(&parent, "child_5");
+    ASSERT_TRUE(child != nullptr);
+
+    child->setObjectName("renamed");
+    EXPECT_EQ(child,
+              gtpy::childindex::findChild<GtObject*>(&parent, "renamed"));
+}
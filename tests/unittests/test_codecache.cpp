@@ -0,0 +1,127 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: test_codecache.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <PythonQtPythonInclude.h>
+
+#include "test_helper.h"
+
+#include <gtpypp.h>
+#include <gtpy_codecache.h>
+#include <gtpy_context.h>
+#include <gtest/gtest.h>
+
+TEST(CodeCache, ReturnsCachedCodeObject)
+{
+    GtpyContextManager::instance()->initContexts();
+
+    GTPY_GIL_SCOPE
+
+    const QString code{"a = 1\nb = a + 1\n"};
+
+    auto first = gtpy::codecache::compile(code, Py_file_input);
+    ASSERT_TRUE(first);
+    EXPECT_TRUE(PyCode_Check(first.get()));
+
+    auto second = gtpy::codecache::compile(code, Py_file_input);
+    EXPECT_EQ(first.get(), second.get());
+
+    // the input type is part of the key
+    auto single = gtpy::codecache::compile(code, Py_single_input);
+    EXPECT_FALSE(single);
+    PyErr_Clear();
+
+    gtpy::codecache::invalidate(code);
+
+    auto third = gtpy::codecache::compile(code, Py_file_input);
+    ASSERT_TRUE(third);
+    EXPECT_NE(first.get(), third.get());
+}
+
+TEST(CodeCache, SyntaxErrorIsNotCached)
+{
+    GtpyContextManager::instance()->initContexts();
+
+    GTPY_GIL_SCOPE
+
+    const int sizeBefore = gtpy::codecache::size();
+
+    auto code = gtpy::codecache::compile("a = ", Py_file_input);
+    EXPECT_FALSE(code);
+    EXPECT_TRUE(PyErr_Occurred() != nullptr);
+    PyErr_Clear();
+
+    EXPECT_EQ(sizeBefore, gtpy::codecache::size());
+}
+
+TEST(CodeCache, ModuleEvalUsesCache)
+{
+    TestPythonContext context;
+
+    auto ctxMgr = GtpyContextManager::instance();
+
+    EXPECT_TRUE(ctxMgr->evalScript(context.id(), "x = 40\nx += 2", false));
+    EXPECT_EQ(42, ctxMgr->getVariable(context.id(), "x").toInt());
+
+    // evaluating the same script again must not depend on the first run
+    EXPECT_TRUE(ctxMgr->evalScript(context.id(), "x = 40\nx += 2", false));
+    EXPECT_EQ(42, ctxMgr->getVariable(context.id(), "x").toInt());
+
+    EXPECT_FALSE(ctxMgr->evalScript(context.id(), "x = ", false, false));
+}
+
+TEST(CodeCache, NonAsciiLiteral)
+{
+    TestPythonContext context;
+
+    auto ctxMgr = GtpyContextManager::instance();
+
+    // characters beyond Latin-1 must survive the compilation
+    const QString text = QString::fromUtf8(
+        "Gr\xc3\xb6\xc3\x9f" "e \xe2\x82\xac \xcf\x80");
+    const QString code = QStringLiteral("s = '%1'\n").arg(text);
+
+    EXPECT_TRUE(ctxMgr->evalScript(context.id(), code, false));
+    EXPECT_EQ(text, ctxMgr->getVariable(context.id(), "s").toString());
+
+    GTPY_GIL_SCOPE
+
+    auto codeObj = gtpy::codecache::compile(code, Py_file_input);
+    ASSERT_TRUE(codeObj);
+
+    // the cached code object yields the same string
+    auto globals = PyPPObject::NewRef(PyDict_New());
+    PyDict_SetItemString(globals.get(), "__builtins__", PyEval_GetBuiltins());
+
+    auto result = PyPPObject::NewRef(
+        PyEval_EvalCode(codeObj.get(), globals.get(), globals.get()));
+    ASSERT_TRUE(result);
+
+    PyObject* s = PyDict_GetItemString(globals.get(), "s");
+    ASSERT_TRUE(s && PyUnicode_Check(s));
+    EXPECT_EQ(text, QString::fromUtf8(PyUnicode_AsUTF8(s)));
+}
+
+TEST(CodeCache, OnlyTaskAndCalculatorContextsUseCache)
+{
+    GtpyContextManager::instance()->initContexts();
+
+    GtpyContext taskContext{GtpyContext::TaskRunContext};
+    GtpyContext editorContext{GtpyContext::ScriptEditorContext};
+
+    EXPECT_TRUE(taskContext.isCodeCacheEnabled());
+    EXPECT_FALSE(editorContext.isCodeCacheEnabled());
+
+    gtpy::codecache::clear();
+
+    EXPECT_TRUE(editorContext.eval("z = 1"));
+    EXPECT_EQ(0, gtpy::codecache::size());
+
+    EXPECT_TRUE(taskContext.eval("z = 1"));
+    EXPECT_EQ(1, gtpy::codecache::size());
+}
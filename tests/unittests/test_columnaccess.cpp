@@ -0,0 +1,127 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: test_columnaccess.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <PythonQtPythonInclude.h>
+
+#include "test_helper.h"
+
+#include <gtest/gtest.h>
+
+#if GT_VERSION >= GT_VERSION_CHECK(2, 0, 0)
+#include <gt_doubleproperty.h>
+#include <gt_stringproperty.h>
+#include <gt_structproperty.h>
+#include <gt_propertystructcontainer.h>
+
+namespace {
+
+/// Object with a struct container whose entries have different members
+class ContainerObject : public GtObject
+{
+public:
+    ContainerObject()
+    {
+        setObjectName("ContainerObject");
+
+        GtPropertyStructDefinition point{"Point"};
+        point.defineMember("eta", gt::makeDoubleProperty(0.0));
+
+        GtPropertyStructDefinition label{"Label"};
+        label.defineMember("text", gt::makeStringProperty(""));
+
+        points.registerAllowedType(point);
+        points.registerAllowedType(label);
+
+        registerPropertyStructContainer(points);
+    }
+
+    GtPropertyStructContainer points{"points", "Points"};
+};
+
+} // namespace
+
+TEST(ColumnAccess, PropertyContainerColumnRoundTrip)
+{
+    auto ctxMgr = GtpyContextManager::instance();
+
+    TestPythonContext context;
+
+    ContainerObject obj;
+    obj.points.newEntry("Point");
+    obj.points.newEntry("Point");
+
+    ctxMgr->addGtObject(context.id(), "obj", &obj, false);
+
+    ASSERT_TRUE(ctxMgr->evalScript(
+        context.id(),
+        "assert obj.setPropertyContainerColumn('points', 'eta', [0.5, 0.7])\n"
+        "col = obj.getPropertyContainerColumn('points', 'eta')\n"
+        "assert list(col) == [0.5, 0.7]\n"
+        "assert not obj.setPropertyContainerColumn('points', 'eta', [1.0])\n"
+        "assert list(obj.getPropertyContainerColumn('points', 'eta')) == "
+        "[0.5, 0.7]\n",
+        false));
+}
+
+TEST(ColumnAccess, PropertyContainerColumnIsNotPartiallyApplied)
+{
+    auto ctxMgr = GtpyContextManager::instance();
+
+    TestPythonContext context;
+
+    // the second entry has no member 'eta'
+    ContainerObject obj;
+    obj.points.newEntry("Point");
+    obj.points.newEntry("Label");
+    obj.points.newEntry("Point");
+
+    ctxMgr->addGtObject(context.id(), "obj", &obj, false);
+
+    ASSERT_TRUE(ctxMgr->evalScript(
+        context.id(),
+        "assert not obj.setPropertyContainerColumn('points', 'eta', "
+        "[1.0, 2.0, 3.0])\n"
+        "assert obj.getPropertyContainerColumn('points', 'eta') is None\n",
+        false));
+
+    bool ok{false};
+    EXPECT_DOUBLE_EQ(0.0, obj.points.at(0).getMemberValToVariant("eta", &ok)
+                     .toDouble());
+    EXPECT_TRUE(ok);
+}
+#else
+#include <gt_datazone0d.h>
+
+TEST(ColumnAccess, EntriesArrayRoundTrip)
+{
+    auto ctxMgr = GtpyContextManager::instance();
+
+    TestPythonContext context;
+
+    GtDataZone0D dataZone;
+    ctxMgr->addGtObject(context.id(), "dz", &dataZone, false);
+
+    ASSERT_TRUE(ctxMgr->evalScript(
+        context.id(),
+        "assert dz.appendData('a', 1.0)\n"
+        "assert dz.appendData('b', 2.0)\n"
+        "assert list(dz.entriesArray()) == [1.0, 2.0]\n"
+        "assert dz.setEntriesArray([3.0, 4.0])\n"
+        "assert list(dz.entriesArray()) == [3.0, 4.0]\n",
+        false));
+
+    // invalid input does not change any value
+    ASSERT_TRUE(ctxMgr->evalScript(
+        context.id(),
+        "assert not dz.setEntriesArray([5.0])\n"
+        "assert not dz.setEntriesArray(['x', 'y'])\n"
+        "assert list(dz.entriesArray()) == [3.0, 4.0]\n",
+        false));
+}
+#endif
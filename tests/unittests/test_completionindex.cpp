@@ -0,0 +1,74 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: test_completionindex.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <gtpy_completionindex.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+GtpyFunction
+function(const QString& name)
+{
+    GtpyFunction func;
+    func.name = name;
+    func.completion = name;
+    func.toolTip = name;
+    return func;
+}
+
+} // namespace
+
+TEST(CompletionIndex, FindByPrefix)
+{
+    QMultiMap<QString, GtpyFunction> completions;
+    for (const auto& name : {"alpha", "alphabet", "beta", "al", "gamma"})
+    {
+        completions.insert(name, function(name));
+    }
+
+    GtpyCompletionIndex index{completions};
+    EXPECT_EQ(5, index.size());
+
+    auto found = index.find("alp");
+    ASSERT_EQ(2, found.size());
+    EXPECT_TRUE(found.contains("alpha"));
+    EXPECT_TRUE(found.contains("alphabet"));
+
+    EXPECT_EQ(3, index.find("al").size());
+    EXPECT_EQ(5, index.find("").size());
+    EXPECT_TRUE(index.find("delta").isEmpty());
+    EXPECT_TRUE(index.find("gammas").isEmpty());
+}
+
+TEST(CompletionIndex, IgnoresCase)
+{
+    QMultiMap<QString, GtpyFunction> completions;
+    completions.insert("MyCalculator", function("MyCalculator"));
+    completions.insert("mycalc", function("mycalc"));
+
+    GtpyCompletionIndex index{completions};
+
+    auto found = index.find("MYCALC");
+    ASSERT_EQ(2, found.size());
+    EXPECT_TRUE(found.contains("mycalculator"));
+    EXPECT_EQ("MyCalculator", found.value("mycalculator").name);
+}
+
+TEST(CompletionIndex, KeepsDuplicateKeys)
+{
+    QMultiMap<QString, GtpyFunction> completions;
+    completions.insert("child", function("child"));
+    completions.insert("child", function("child()"));
+
+    GtpyCompletionIndex index{completions};
+
+    EXPECT_EQ(2, index.find("ch").size());
+    EXPECT_TRUE(GtpyCompletionIndex{}.isEmpty());
+}
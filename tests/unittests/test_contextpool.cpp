@@ -0,0 +1,151 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: test_contextpool.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <PythonQtPythonInclude.h>
+
+#include "test_helper.h"
+
+#include <gtpypp.h>
+#include <gtpy_code.h>
+#include <gtpy_contextpool.h>
+#include <gtest/gtest.h>
+
+TEST(ContextPool, ResetRestoresInitialState)
+{
+    GtpyContextManager::instance()->initContexts();
+
+    GtpyContext context{GtpyContext::TaskRunContext};
+
+    ASSERT_TRUE(context.eval("x = 42"));
+    ASSERT_TRUE(context.eval(gtpy::code::enableAppConsoleLogging(false)));
+    context.setLoggingPrefix("prefix");
+
+    ASSERT_TRUE(context.reset());
+
+    EXPECT_TRUE(context.loggingPrefix().isEmpty());
+
+    // variables defined after the construction are removed
+    EXPECT_FALSE(context.eval("x"));
+
+    // predefined variables and functions are restored
+    EXPECT_TRUE(context.eval(QStringLiteral("assert %1 == True")
+                             .arg(gtpy::code::attrs::LOGGING_ENABLED)));
+    EXPECT_TRUE(context.eval(QStringLiteral("assert callable(%1)")
+                             .arg(gtpy::code::funcs::PROJECT_PATH_F_NAME)));
+
+    // dunder entries such as __builtins__ are shared, not copied
+    EXPECT_TRUE(context.eval("assert len([1, 2]) == 2"));
+}
+
+TEST(ContextPool, CapacityZeroDisablesPooling)
+{
+    GtpyContextManager::instance()->initContexts();
+
+    GtpyContextPool pool;
+
+    auto context = pool.acquire(GtpyContext::ScriptEditorContext);
+    ASSERT_TRUE(context != nullptr);
+    EXPECT_EQ(GtpyContext::ScriptEditorContext, context->type());
+
+    pool.release(std::move(context));
+
+    auto stats = pool.statistics(GtpyContext::ScriptEditorContext);
+    EXPECT_EQ(0, stats.size);
+    EXPECT_EQ(0u, stats.hits);
+    EXPECT_EQ(0u, stats.misses);
+}
+
+TEST(ContextPool, ReleasedContextIsReused)
+{
+    GtpyContextManager::instance()->initContexts();
+
+    // the refill is disabled by default, so the pool is only filled by
+    // released contexts
+    GtpyContextPool pool;
+    pool.setCapacity(GtpyContext::CalculatorRunContext, 1);
+
+    auto context = pool.acquire(GtpyContext::CalculatorRunContext);
+    ASSERT_TRUE(context != nullptr);
+    ASSERT_TRUE(context->eval("y = 1"));
+
+    auto* rawPtr = context.get();
+    pool.release(std::move(context));
+
+    auto stats = pool.statistics(GtpyContext::CalculatorRunContext);
+    EXPECT_EQ(1, stats.size);
+    EXPECT_EQ(0u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+
+    context = pool.acquire(GtpyContext::CalculatorRunContext);
+    ASSERT_EQ(rawPtr, context.get());
+    EXPECT_FALSE(context->eval("y"));
+
+    stats = pool.statistics(GtpyContext::CalculatorRunContext);
+    EXPECT_EQ(0, stats.size);
+    EXPECT_EQ(1u, stats.hits);
+}
+
+TEST(ContextPool, ManagerReusesContexts)
+{
+    auto ctxMgr = GtpyContextManager::instance();
+    ctxMgr->initContexts();
+
+    const auto before = ctxMgr->contextPoolStatistics(
+        GtpyContextManager::TaskRunContext);
+
+    {
+        TestPythonContext context{GtpyContextManager::TaskRunContext};
+        ASSERT_TRUE(ctxMgr->evalScript(context.id(), "z = 3", false));
+    }
+
+    TestPythonContext context{GtpyContextManager::TaskRunContext};
+
+    // a reused context must not contain any variables of the previous run
+    EXPECT_FALSE(ctxMgr->evalScript(context.id(), "z", false, false));
+
+    const auto after = ctxMgr->contextPoolStatistics(
+        GtpyContextManager::TaskRunContext);
+
+    EXPECT_EQ(before.hits + before.misses + 2, after.hits + after.misses);
+}
+
+TEST(ContextPool, SystemContextsAreCreatedOnAccess)
+{
+    auto ctxMgr = GtpyContextManager::instance();
+    ctxMgr->initContexts();
+
+    // user contexts do not take the ids of system contexts that are not
+    // created yet
+    TestPythonContext context{GtpyContextManager::ScriptEditorContext};
+    EXPECT_GE(context.id(), 100);
+
+    ASSERT_TRUE(ctxMgr->context(GtpyContextManager::CollectionContext));
+    EXPECT_TRUE(ctxMgr->evalScript(GtpyContextManager::CollectionContext,
+                                   "w = 1", false));
+    EXPECT_TRUE(ctxMgr->evalScript(GtpyContextManager::CollectionContext,
+                                   "assert w == 1", false));
+}
+
+TEST(ContextPool, ContextOutlivesDeletion)
+{
+    auto ctxMgr = GtpyContextManager::instance();
+    ctxMgr->initContexts();
+
+    const int id = ctxMgr->createNewContext(
+        GtpyContextManager::ScriptEditorContext);
+
+    auto con = ctxMgr->context(id);
+    ASSERT_TRUE(con);
+
+    ASSERT_TRUE(ctxMgr->deleteContext(id));
+    EXPECT_FALSE(ctxMgr->context(id));
+
+    // the held context is neither destroyed nor handed out again
+    EXPECT_TRUE(con->eval("v = 1\nassert v == 1"));
+}
@@ -0,0 +1,256 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: test_extendedwrapper.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <PythonQtPythonInclude.h>
+
+#include "test_helper.h"
+
+#include <gtpypp.h>
+#include <gtest/gtest.h>
+
+TEST(ExtendedWrapper, PropertyAccessInLoop)
+{
+    auto ctxMgr = GtpyContextManager::instance();
+
+    TestPythonContext context;
+
+    MyCalculator calc;
+    ctxMgr->addGtObject(context.id(), "calc", &calc, false);
+
+    // repeated accesses are served by the attribute dispatch table
+    ASSERT_TRUE(ctxMgr->evalScript(context.id(),
+                                   "for i in range(1000):\n"
+                                   "    calc.intprop = i\n"
+                                   "    calc.setDoubleprop(calc.intprop / 2)\n",
+                                   false));
+
+    EXPECT_EQ(999, calc.intProp.get());
+    EXPECT_DOUBLE_EQ(499.5, calc.doubleProp.get());
+}
+
+TEST(ExtendedWrapper, SameClassDifferentObjects)
+{
+    auto ctxMgr = GtpyContextManager::instance();
+
+    TestPythonContext context;
+
+    MyCalculator first;
+    MyCalculator second;
+    ctxMgr->addGtObject(context.id(), "first", &first, false);
+    ctxMgr->addGtObject(context.id(), "second", &second, false);
+
+    ASSERT_TRUE(ctxMgr->evalScript(context.id(),
+                                   "first.strprop = 'a'\n"
+                                   "second.strprop = 'b'\n",
+                                   false));
+
+    EXPECT_EQ("a", first.strProp.get());
+    EXPECT_EQ("b", second.strProp.get());
+}
+
+TEST(ExtendedWrapper, ChildShadowsProperty)
+{
+    auto ctxMgr = GtpyContextManager::instance();
+
+    TestPythonContext context;
+
+    MyCalculator calc;
+    ctxMgr->addGtObject(context.id(), "calc", &calc, false);
+
+    // warm up the dispatch table before the child is added
+    ASSERT_TRUE(ctxMgr->evalScript(context.id(), "calc.intprop", false));
+
+    auto* child = new MyObject;
+    child->setObjectName("intprop");
+    calc.appendChild(child);
+
+    EXPECT_TRUE(ctxMgr->evalScript(
+        context.id(), "assert calc.intprop.objectName() == 'intprop'", false));
+
+    EXPECT_FALSE(ctxMgr->evalScript(context.id(), "calc.unknownAttr",
+                                    false, false));
+
+    // a cached miss must not hide a child added afterwards
+    auto* other = new MyObject;
+    other->setObjectName("unknownAttr");
+    calc.appendChild(other);
+
+    EXPECT_TRUE(ctxMgr->evalScript(
+        context.id(), "assert calc.unknownAttr.objectName() == 'unknownAttr'",
+        false));
+}
+
+TEST(ExtendedWrapper, BulkPropertyAccess)
+{
+    auto ctxMgr = GtpyContextManager::instance();
+
+    TestPythonContext context;
+
+    MyCalculator calc;
+    ctxMgr->addGtObject(context.id(), "calc", &calc, false);
+
+    ASSERT_TRUE(ctxMgr->evalScript(
+        context.id(),
+        "calc.setProperties({'int prop': 7, 'str prop': 'bulk'})\n"
+        "values = calc.getProperties(['int prop', 'str prop'])\n"
+        "assert values == {'int prop': 7, 'str prop': 'bulk'}\n"
+        "snapshot = calc.snapshotProperties()\n"
+        "assert snapshot[''] == calc.getProperties()\n",
+        false));
+
+    EXPECT_EQ(7, calc.intProp.get());
+    EXPECT_EQ("bulk", calc.strProp.get());
+
+    // unknown ids do not change any property
+    EXPECT_FALSE(ctxMgr->evalScript(
+        context.id(), "calc.setProperties({'int prop': 8, 'unknown': 1})",
+        false, false));
+    EXPECT_EQ(7, calc.intProp.get());
+
+    // an invalid value does not change any property either
+    EXPECT_FALSE(ctxMgr->evalScript(
+        context.id(),
+        "calc.setProperties({'str prop': 'changed', 'int prop': 'abc'})",
+        false, false));
+    EXPECT_EQ(7, calc.intProp.get());
+    EXPECT_EQ("bulk", calc.strProp.get());
+}
+
+TEST(ExtendedWrapper, SetPropertiesNotifiesOnce)
+{
+    auto ctxMgr = GtpyContextManager::instance();
+
+    TestPythonContext context;
+
+    MyCalculator calc;
+    ctxMgr->addGtObject(context.id(), "calc", &calc, false);
+
+    int objectChanges = 0;
+    QStringList propertyChanges;
+
+    using ObjectSignal = void (GtObject::*)(GtObject*);
+    using PropertySignal = void (GtObject::*)(GtObject*, GtAbstractProperty*);
+
+    QObject::connect(&calc, static_cast<ObjectSignal>(&GtObject::dataChanged),
+                     [&](GtObject*){ ++objectChanges; });
+    QObject::connect(&calc,
+                     static_cast<PropertySignal>(&GtObject::dataChanged),
+                     [&](GtObject*, GtAbstractProperty* prop){
+        propertyChanges.append(prop->ident());
+    });
+
+    ASSERT_TRUE(ctxMgr->evalScript(
+        context.id(), "calc.setProperties({'int prop': 1, 'str prop': 'a'})",
+        false));
+
+    EXPECT_EQ(1, objectChanges);
+    propertyChanges.sort();
+    EXPECT_EQ((QStringList{"int prop", "str prop"}), propertyChanges);
+}
+
+TEST(ExtendedWrapper, SnapshotRejectsDuplicatePaths)
+{
+    auto ctxMgr = GtpyContextManager::instance();
+
+    TestPythonContext context;
+
+    MyCalculator calc;
+
+    for (int i = 0; i < 2; ++i)
+    {
+        auto* child = new MyObject;
+        child->setObjectName("twin");
+        calc.appendChild(child);
+    }
+
+    ctxMgr->addGtObject(context.id(), "calc", &calc, false);
+
+    EXPECT_FALSE(ctxMgr->evalScript(context.id(),
+                                    "calc.snapshotProperties()",
+                                    false, false));
+}
+
+TEST(ExtendedWrapper, WrapperIdentityIsStable)
+{
+    auto ctxMgr = GtpyContextManager::instance();
+
+    TestPythonContext context;
+
+    MyCalculator calc;
+    auto* child = new MyObject;
+    child->setObjectName("child");
+    calc.appendChild(child);
+
+    ctxMgr->addGtObject(context.id(), "calc", &calc, false);
+
+    ASSERT_TRUE(ctxMgr->evalScript(
+        context.id(),
+        "a = calc.child\n"
+        "assert a is calc.child\n"
+        "assert a is calc.findGtChild('child')\n"
+        "assert a is calc.findGtChildren()[0]\n"
+        "assert a.findGtParent() is a.findGtParent()\n",
+        false));
+
+    // a new object must not get the wrapper of a destroyed one, even if it
+    // is allocated at the same address
+    delete child;
+    auto* replacement = new MyObject;
+    replacement->setObjectName("child");
+    calc.appendChild(replacement);
+
+    EXPECT_TRUE(ctxMgr->evalScript(
+        context.id(),
+        "b = calc.child\n"
+        "assert b is not a\n"
+        "assert b.objectName() == 'child'\n",
+        false));
+}
+
+TEST(ExtendedWrapper, PropertyAccessTiming)
+{
+    auto ctxMgr = GtpyContextManager::instance();
+
+    TestPythonContext context;
+
+    MyCalculator calc;
+    ctxMgr->addGtObject(context.id(), "calc", &calc, false);
+
+    // Compares reading the last registered property, which was the worst
+    // case of the former linear property scan, with resolving a slot of the
+    // PythonQt wrapper, which is the baseline of any attribute access.
+    ASSERT_TRUE(ctxMgr->evalScript(
+        context.id(),
+        "import time\n"
+        "def bench(f, n=20000):\n"
+        "    f()\n"
+        "    t = time.perf_counter()\n"
+        "    for _ in range(n):\n"
+        "        f()\n"
+        "    return time.perf_counter() - t\n"
+        "prop_time = bench(lambda: calc.objlinkprop)\n"
+        "slot_time = bench(lambda: calc.objectName)\n"
+        "miss_time = bench(lambda: hasattr(calc, 'unknownAttr'), 2000)\n",
+        false));
+
+    const double propTime = ctxMgr->getVariable(context.id(),
+                                                "prop_time").toDouble();
+    const double slotTime = ctxMgr->getVariable(context.id(),
+                                                "slot_time").toDouble();
+    const double missTime = ctxMgr->getVariable(context.id(),
+                                                "miss_time").toDouble();
+
+    // average time per access in nanoseconds
+    RecordProperty("property_access_ns", int(propTime / 20000 * 1e9));
+    RecordProperty("slot_access_ns", int(slotTime / 20000 * 1e9));
+    RecordProperty("miss_ns", int(missTime / 2000 * 1e9));
+
+    // generous factor to keep the test stable on loaded machines
+    EXPECT_LT(propTime, 4 * slotTime);
+}
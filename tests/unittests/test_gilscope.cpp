@@ -0,0 +1,160 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: test_gilscope.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <algorithm>
+#include <chrono>
+
+#include "test_helper.h"
+
+#include <gtpy_gilscope.h>
+#include <gtpy_threadscope.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+int nestedScopeLine = 0;
+
+void
+nestedScope()
+{
+    nestedScopeLine = __LINE__ + 1;
+    GTPY_GIL_SCOPE
+}
+
+} // namespace
+
+class TestGilScope : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // initializes Python and releases the GIL of the main thread
+        GtpyContextManager::instance();
+    }
+
+    void TearDown() override
+    {
+        GtpyGilScope::setInstrumentationEnabled(false);
+        GtpyGilScope::resetStatistics();
+    }
+};
+
+TEST_F(TestGilScope, NestedScopes)
+{
+    ASSERT_FALSE(PyGILState_Check());
+
+    {
+        GTPY_GIL_SCOPE
+        EXPECT_TRUE(PyGILState_Check());
+
+        {
+            GTPY_GIL_SCOPE
+            EXPECT_TRUE(PyGILState_Check());
+        }
+
+        // the nested scope must not release the GIL of the outer one
+        EXPECT_TRUE(PyGILState_Check());
+    }
+
+    EXPECT_FALSE(PyGILState_Check());
+}
+
+TEST_F(TestGilScope, ScopeInsideThreadScope)
+{
+    GTPY_GIL_SCOPE
+
+    {
+        GtpyThreadScope threadScope;
+        EXPECT_FALSE(PyGILState_Check());
+
+        // the enclosing scope released the GIL, so it is acquired again
+        GTPY_GIL_SCOPE
+        EXPECT_TRUE(PyGILState_Check());
+    }
+
+    EXPECT_TRUE(PyGILState_Check());
+}
+
+TEST_F(TestGilScope, RecordsWaitTimePerCallSite)
+{
+    GtpyGilScope::setInstrumentationEnabled(true);
+    GtpyGilScope::resetStatistics();
+
+    int line = 0;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        line = __LINE__ + 1;
+        GTPY_GIL_SCOPE
+
+        // nested scopes do not acquire the GIL and are not recorded
+        nestedScope();
+    }
+
+    auto stats = GtpyGilScope::statistics();
+
+    auto iter = std::find_if(stats.begin(), stats.end(),
+                             [line](const GtpyGilScope::Statistics& s){
+        return s.line == line && s.file.endsWith("test_gilscope.cpp");
+    });
+
+    ASSERT_TRUE(iter != stats.end());
+    EXPECT_EQ(3, iter->count);
+    EXPECT_GE(iter->waitTime, 0);
+
+    EXPECT_TRUE(std::none_of(stats.begin(), stats.end(),
+                             [](const GtpyGilScope::Statistics& s){
+        return s.line == nestedScopeLine;
+    }));
+}
+
+TEST_F(TestGilScope, NestedScopeOverhead)
+{
+    using Clock = std::chrono::steady_clock;
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+
+    constexpr int n = 100000;
+
+    ASSERT_FALSE(PyGILState_Check());
+
+    // without an enclosing scope, each scope acquires and releases the GIL
+    auto start = Clock::now();
+
+    for (int i = 0; i < n; ++i)
+    {
+        GTPY_GIL_SCOPE
+    }
+
+    auto acquireTime = duration_cast<nanoseconds>(Clock::now() - start)
+            .count();
+
+    long long nestedTime = 0;
+
+    {
+        GTPY_GIL_SCOPE
+
+        start = Clock::now();
+
+        for (int i = 0; i < n; ++i)
+        {
+            GTPY_GIL_SCOPE
+        }
+
+        nestedTime = duration_cast<nanoseconds>(Clock::now() - start)
+                .count();
+    }
+
+    RecordProperty("nsPerAcquiringScope", static_cast<int>(acquireTime / n));
+    RecordProperty("nsPerNestedScope", static_cast<int>(nestedTime / n));
+
+    // a nested scope neither allocates nor ensures the GIL again
+    EXPECT_LT(nestedTime, acquireTime);
+}
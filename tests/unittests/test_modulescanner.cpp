@@ -0,0 +1,120 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: test_modulescanner.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QDataStream>
+#include <QTemporaryDir>
+
+#include <gtpy_modulescanner.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+void
+touch(const QString& path)
+{
+    QFile file{path};
+    file.open(QIODevice::WriteOnly);
+}
+
+/**
+ * Writes a zip archive that only consists of the central directory with the
+ * given file names, which is all the scanner reads.
+ */
+void
+writeZip(const QString& path, const QStringList& names)
+{
+    QByteArray dir;
+    QDataStream out{&dir, QIODevice::WriteOnly};
+    out.setByteOrder(QDataStream::LittleEndian);
+
+    for (const auto& name : names)
+    {
+        const QByteArray utf8 = name.toUtf8();
+
+        out << quint32(0x02014b50);
+        for (int i = 0; i < 12; ++i) out << quint16(0);
+        out << quint16(utf8.size()) << quint16(0) << quint16(0);
+        for (int i = 0; i < 4; ++i) out << quint16(0);
+        out << quint32(0);
+        out.writeRawData(utf8.constData(), utf8.size());
+    }
+
+    QByteArray end;
+    QDataStream endOut{&end, QIODevice::WriteOnly};
+    endOut.setByteOrder(QDataStream::LittleEndian);
+    endOut << quint32(0x06054b50) << quint16(0) << quint16(0)
+           << quint16(names.size()) << quint16(names.size())
+           << quint32(dir.size()) << quint32(0) << quint16(0);
+
+    QFile file{path};
+    file.open(QIODevice::WriteOnly);
+    file.write(dir);
+    file.write(end);
+}
+
+} // namespace
+
+TEST(ModuleScanner, ScanDirectory)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    QDir dir{tmp.path()};
+
+    touch(dir.filePath("plain.py"));
+    touch(dir.filePath("compiled.pyc"));
+    touch(dir.filePath("ext.cpython-39-x86_64-linux-gnu.so"));
+    touch(dir.filePath("winext.cp39-win_amd64.pyd"));
+    touch(dir.filePath("two.dots.py"));
+    touch(dir.filePath("readme.txt"));
+    touch(dir.filePath("__init__.py"));
+
+    ASSERT_TRUE(dir.mkpath("package"));
+    touch(dir.filePath("package/__init__.py"));
+
+    ASSERT_TRUE(dir.mkpath("nopackage"));
+    touch(dir.filePath("nopackage/module.py"));
+
+    ASSERT_TRUE(dir.mkpath("dotted.package"));
+    touch(dir.filePath("dotted.package/__init__.py"));
+
+    auto modules = GtpyModuleScanner::scanDirectory(tmp.path());
+
+    EXPECT_EQ(QStringList({"compiled", "ext", "package", "plain", "winext"}),
+              modules);
+}
+
+TEST(ModuleScanner, MissingDirectory)
+{
+    EXPECT_TRUE(GtpyModuleScanner::scanDirectory("/does/not/exist").isEmpty());
+}
+
+TEST(ModuleScanner, ScanArchive)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    const QString zip = QDir{tmp.path()}.filePath("python39.zip");
+
+    writeZip(zip, {"plain.py", "compiled.pyc", "readme.txt", "package/",
+                   "package/__init__.py", "package/sub.py",
+                   "nopackage/module.py", "deep/package/__init__.py"});
+
+    EXPECT_EQ(QStringList({"compiled", "package", "plain"}),
+              GtpyModuleScanner::scanDirectory(zip));
+
+    // files that are no zip archives do not contain modules
+    const QString text = QDir{tmp.path()}.filePath("plain.txt");
+    touch(text);
+
+    EXPECT_TRUE(GtpyModuleScanner::scanArchive(text).isEmpty());
+}
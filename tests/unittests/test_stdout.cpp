@@ -0,0 +1,64 @@
+/* GTlab - Gas Turbine laboratory
+ * Source File: test_stdout.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ *
+ * Created on: 17.10.2026
+ */
+
+#include "test_helper.h"
+
+#include <gtest/gtest.h>
+
+class TestStdOut : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        conn = QObject::connect(GtpyContextManager::instance(),
+                                &GtpyContextManager::pythonMessage,
+                                [this](const QString& message, int id,
+                                       const QString&){
+            if (id != context.id()) return;
+
+            output += message;
+            ++batches;
+        });
+    }
+
+    void TearDown() override
+    {
+        QObject::disconnect(conn);
+    }
+
+    TestPythonContext context;
+
+    QMetaObject::Connection conn;
+
+    QString output;
+
+    int batches{0};
+};
+
+TEST_F(TestStdOut, OutputIsBatched)
+{
+    ASSERT_TRUE(GtpyContextManager::instance()->evalScript(
+        context.id(), "for i in range(1000):\n    print(i)\n", true));
+
+    QString expected;
+    for (int i = 0; i < 1000; ++i) expected += QString::number(i) + "\n";
+
+    // all output is flushed at the end of the evaluation
+    EXPECT_EQ(expected, output);
+    EXPECT_LT(batches, 1000);
+}
+
+TEST_F(TestStdOut, NoOutputIfDisabled)
+{
+    ASSERT_TRUE(GtpyContextManager::instance()->evalScript(
+        context.id(), "print('hidden')", false));
+
+    EXPECT_TRUE(output.isEmpty());
+    EXPECT_EQ(0, batches);
+}
@@ -10,6 +10,7 @@
 
 #include <gtpypp.h>
 #include <gtpy_decorator.h>
+#include <gtpy_convert.h>
 #include <gtest/gtest.h>
 
 TEST(VariantConvert, intAsVariant)
@@ -89,3 +90,95 @@ TEST(VariantConvert, addVariableObject)
 
     EXPECT_EQ("Object3", objPtr->objectName());
 }
+
+TEST(VariantConvert, doubleBufferRoundTrip)
+{
+    TestPythonContext context;
+
+    GTPY_GIL_SCOPE
+
+    QVector<double> values{1.0, -2.5, 1e300};
+
+    auto view = gtpy::convert::toDoubleBuffer(values);
+    ASSERT_TRUE(view);
+    EXPECT_TRUE(PyMemoryView_Check(view.get()));
+    EXPECT_EQ(3, PyObject_Length(view.get()));
+
+    QVector<double> result;
+    ASSERT_TRUE(gtpy::convert::fromDoubleBuffer(view.get(), result));
+    EXPECT_EQ(values, result);
+
+    // plain sequences of numbers are read value by value
+    auto list = PyPPObject::NewRef(Py_BuildValue("[i,d]", 3, 0.5));
+    ASSERT_TRUE(gtpy::convert::fromDoubleBuffer(list.get(), result));
+    EXPECT_EQ((QVector<double>{3.0, 0.5}), result);
+
+    // invalid input leaves the values unchanged
+    auto str = PyPPObject::fromString("abc");
+    EXPECT_FALSE(gtpy::convert::fromDoubleBuffer(str.get(), result));
+    EXPECT_EQ((QVector<double>{3.0, 0.5}), result);
+}
+
+TEST(VariantConvert, largeMapRoundTrip)
+{
+    TestPythonContext context;
+
+    GTPY_GIL_SCOPE
+
+    QMap<QString, double> map;
+    for (int i = 0; i < 100000; ++i)
+    {
+        map.insert(QStringLiteral("key_%1").arg(i), i * 0.5);
+    }
+
+    auto dict = PyPPObject::NewRef(
+        GtpyTypeConversion::convertFromQMapStringDouble(&map, 0));
+    ASSERT_TRUE(dict);
+    ASSERT_TRUE(PyDict_Check(dict.get()));
+    EXPECT_EQ(map.size(), PyDict_Size(dict.get()));
+
+    QMap<QString, double> result;
+    ASSERT_TRUE(GtpyTypeConversion::convertToQMapStringDouble(dict.get(),
+                                                              &result, 0,
+                                                              false));
+    EXPECT_EQ(map, result);
+}
+
+TEST(VariantConvert, mapValuesOfOtherTypes)
+{
+    TestPythonContext context;
+
+    GTPY_GIL_SCOPE
+
+    // ints are accepted as doubles and vice versa
+    auto dict = PyPPObject::NewRef(Py_BuildValue("{s:i,s:d}", "a", 1,
+                                                 "b", 2.0));
+
+    QMap<QString, double> doubles;
+    ASSERT_TRUE(GtpyTypeConversion::convertToQMapStringDouble(dict.get(),
+                                                              &doubles, 0,
+                                                              false));
+    EXPECT_DOUBLE_EQ(1.0, doubles.value("a"));
+    EXPECT_DOUBLE_EQ(2.0, doubles.value("b"));
+
+    QMap<QString, int> ints;
+    ASSERT_TRUE(GtpyTypeConversion::convertToQMapStringInt(dict.get(),
+                                                           &ints, 0, false));
+    EXPECT_EQ(1, ints.value("a"));
+    EXPECT_EQ(2, ints.value("b"));
+}
+
+TEST(VariantConvert, mapIntOutOfRange)
+{
+    TestPythonContext context;
+
+    GTPY_GIL_SCOPE
+
+    // values beyond the range of int are not truncated
+    auto dict = PyPPObject::NewRef(Py_BuildValue("{s:L}", "a",
+                                                 1LL << 40));
+
+    QMap<QString, int> ints;
+    EXPECT_FALSE(GtpyTypeConversion::convertToQMapStringInt(dict.get(),
+                                                            &ints, 0, false));
+}